@@ -9,6 +9,8 @@
 #ifndef ALLOCATOR_H
 #define ALLOCATOR_H
 #include <cstddef>
+#include <limits>
+#include <new>
 #include <utility>
 
 namespace atl {
@@ -36,15 +38,30 @@ public:
     template<typename U>
     allocator(const allocator<U>&) noexcept {}
 
-    // Allocates memory for n objects of type Type.
+    // Returns the largest n for which n * sizeof(Type) does not overflow.
+    static constexpr std::size_t max_size() noexcept {
+        return std::numeric_limits<std::size_t>::max() / sizeof(Type);
+    }
+
+    // Allocates memory for n objects of type Type, aligned for Type even when it is over-aligned.
     pointer allocate(std::size_t n) {
-        return static_cast<pointer>(::operator new(n * sizeof(Type)));
-        
+        if (n > max_size()) {
+            throw std::bad_array_new_length();
+        }
+        if constexpr (over_aligned) {
+            return static_cast<pointer>(::operator new(n * sizeof(Type), std::align_val_t(alignof(Type))));
+        } else {
+            return static_cast<pointer>(::operator new(n * sizeof(Type)));
+        }
     }
     
-    // Deallocates the memory pointed to by p.
-    void deallocate(pointer p, std::size_t) {
-        ::operator delete(p);
+    // Deallocates the memory pointed to by p, which must come from allocate(n); the size lets malloc skip its lookup.
+    void deallocate(pointer p, std::size_t n) {
+        if constexpr (over_aligned) {
+            ::operator delete(p, n * sizeof(Type), std::align_val_t(alignof(Type)));
+        } else {
+            ::operator delete(p, n * sizeof(Type));
+        }
     }
 
     // Constructs an object of type Type in the allocated memory using the provided arguments.
@@ -62,6 +79,10 @@ public:
     // Destructor.
     ~allocator() {}
 
+private:
+    // Whether Type needs more alignment than plain operator new guarantees.
+    static constexpr bool over_aligned = alignof(Type) > __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
 };
 
 
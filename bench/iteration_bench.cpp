@@ -0,0 +1,57 @@
+// Iteration Benchmark (atl::forward_list::for_each)
+
+/*
+    Compares summing a list through range-for (Iterator) with the internal loops of
+    for_each and for_each_while, for a list that fits in cache and one that does not.
+
+    g++ -std=c++20 -O2 -I.. iteration_bench.cpp -o iteration_bench && ./iteration_bench
+*/
+
+#include "../forward_list.tpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+namespace {
+
+    // Returns the best time per element, in nanoseconds, of sum over reps runs; keeps the result observable.
+    template<typename Sum>
+    double time_sum(std::size_t n, int reps, Sum sum) {
+        double best = 1e300;
+        for (int r = 0; r < reps; ++r) {
+            auto start = std::chrono::steady_clock::now();
+            volatile long result = sum();
+            (void)result;
+            auto stop = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double, std::nano>(stop - start).count() / static_cast<double>(n));
+        }
+        return best;
+    }
+
+} // namespace
+
+int main() {
+    std::printf("%-10s %12s %12s %16s\n", "elements", "range-for", "for_each", "for_each_while");
+    for (std::size_t n : {std::size_t(1) << 12, std::size_t(1) << 22}) {
+        atl::forward_list<long> list;
+        for (std::size_t i = 0; i < n; ++i) list.push_front(static_cast<long>(i));
+        int reps = n < 100000 ? 1000 : 10;
+
+        double range_for = time_sum(n, reps, [&] {
+            long s = 0;
+            for (long value : list) s += value;
+            return s;
+        });
+        double for_each = time_sum(n, reps, [&] {
+            long s = 0;
+            list.for_each([&s](long value) { s += value; });
+            return s;
+        });
+        double for_each_while = time_sum(n, reps, [&] {
+            long s = 0;
+            list.for_each_while([&s](long value) { s += value; return true; });
+            return s;
+        });
+        std::printf("%-10zu %9.2f ns %9.2f ns %13.2f ns\n", n, range_for, for_each, for_each_while);
+    }
+}
@@ -0,0 +1,472 @@
+// Durable Forward List (atl::durable_forward_list)
+
+/*
+    The atl::durable_forward_list class template keeps an atl::forward_list of trivially
+    copyable values crash-consistent on local disk. Every mutation is appended to a
+    write-ahead log as a compact checksummed record; records are buffered and made durable
+    together with one fdatasync per group (group commit), either when the group fills up
+    or, from a background flusher thread, once its first record has waited group_delay.
+    commit() makes every mutation so far durable before it returns, so callers that
+    acknowledge a mutation to someone else call it first. Once the log grows past a limit,
+    the whole list is written to a snapshot file, swapped in by rename, and the log starts
+    over. Opening the list loads the snapshot and replays the log, stopping at the first
+    torn or corrupt record.
+*/
+
+#ifndef DURABLE_FORWARD_LIST_H
+#define DURABLE_FORWARD_LIST_H
+
+#include "forward_list.tpp"
+#include "fwd_list_io.h"
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace atl {
+
+    /*
+        Durability Options (atl::durability_options)
+        This struct decides when buffered records are synced and when a snapshot is taken.
+    */
+    struct durability_options {
+
+        std::size_t group_commit{1024}; // Records buffered before they are written and synced together.
+        std::chrono::microseconds group_delay{1000}; // Longest a buffered record waits for its group to fill; 0 syncs every record.
+        std::size_t snapshot_bytes{64 * 1024 * 1024}; // Log size after which a commit also takes a snapshot.
+    };
+
+namespace detail {
+
+    // Returns the 32-bit FNV-1a checksum of bytes, continuing from seed.
+    inline std::uint32_t checksum(const void* data, std::size_t bytes, std::uint32_t seed = 2166136261u) noexcept {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < bytes; ++i) {
+            seed = (seed ^ p[i]) * 16777619u;
+        }
+        return seed;
+    }
+
+} // namespace detail
+
+
+    /*
+        Durable Forward List Class (atl::durable_forward_list)
+        The log and the snapshot carry a generation number. A snapshot is renamed into place
+        before the log is reset, so after a crash in between the log is older than the
+        snapshot and is ignored instead of being replayed twice. The list itself belongs to
+        the calling thread; the flusher only touches the buffered records and the log file.
+    */
+    template<typename Type, typename Allocator = allocator<fwd_list_node<Type>>>
+    class durable_forward_list {
+        static_assert(std::is_trivially_copyable_v<Type>, "atl::durable_forward_list logs values as raw bytes");
+
+    public:
+        using List = forward_list<Type, Allocator>;
+        using ConstIterator = typename List::ConstIterator;
+
+        // Constructor opening (or creating) the list stored at path.snap and path.log and replaying the log.
+        explicit durable_forward_list(std::string path, const durability_options& options = durability_options(),
+                                      const Allocator& a = Allocator())
+            : list(a), base(std::move(path)), opts(options) {
+            load_snapshot();
+            open_log();
+            if (opts.group_delay.count() > 0) flusher = std::thread([this] { flush_loop(); });
+        }
+
+        // Destructor that stops the flusher, makes pending records durable and closes the log.
+        ~durable_forward_list() {
+            if (flusher.joinable()) {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    stopping = true;
+                }
+                wake.notify_one();
+                flusher.join();
+            }
+            try {
+                commit();
+            } catch (...) {
+            }
+            if (log_fd >= 0) ::close(log_fd);
+        }
+
+        durable_forward_list(const durable_forward_list&) = delete;
+        durable_forward_list& operator=(const durable_forward_list&) = delete;
+
+        // Returns the list; it must only be changed through this object.
+        const List& view() const noexcept {
+            return list;
+        }
+
+        // Returns a constant reference to the first element in the list.
+        const Type& front() const {
+            return list.front();
+        }
+
+        // Checks if the list is empty.
+        bool empty() const noexcept {
+            return list.empty();
+        }
+
+        // Inserts a new element at the front of the list.
+        void push_front(const Type& value) {
+            list.push_front(value);
+            log(op_push_front, &value, sizeof(Type));
+        }
+
+        // Removes the first element from the list.
+        void pop_front() {
+            if (list.empty()) return;
+            list.pop_front();
+            log(op_pop_front, nullptr, 0);
+        }
+
+        // Removes all elements equal to value.
+        void remove(const Type& value) {
+            list.remove(value);
+            log(op_remove, &value, sizeof(Type));
+        }
+
+        // Moves the elements of other after the element at position pos, which must exist.
+        // other is an ordinary list; its elements are logged by value.
+        template<typename OtherAllocator>
+        void splice_after(size_t pos, forward_list<Type, OtherAllocator>& other) {
+            std::vector<unsigned char> payload(sizeof(std::uint64_t));
+            std::uint64_t where = pos;
+            std::memcpy(payload.data(), &where, sizeof(where));
+            for (const Type& value : other) {
+                const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&value);
+                payload.insert(payload.end(), bytes, bytes + sizeof(Type));
+            }
+            List moved(other.begin(), other.end(), list.get_allocator());
+            other.clear();
+            list.splice_after(position(pos), moved);
+            log(op_splice_after, payload.data(), payload.size());
+        }
+
+        // Clears the list.
+        void clear() {
+            list.clear();
+            log(op_clear, nullptr, 0);
+        }
+
+        // Writes and syncs every buffered record, then takes a snapshot if the log has grown past the limit.
+        // Every mutation made before the call is durable once it returns. Rethrows a failure of the flusher.
+        void commit() {
+            std::lock_guard<std::mutex> io_lock(io);
+            write_pending();
+            if (flush_error) std::rethrow_exception(std::exchange(flush_error, nullptr));
+            if (static_cast<std::size_t>(log_end) >= opts.snapshot_bytes) take_snapshot();
+        }
+
+        // Writes the whole list to a new snapshot and starts an empty log.
+        void snapshot() {
+            std::lock_guard<std::mutex> io_lock(io);
+            take_snapshot();
+        }
+
+        // Returns an iterator to the beginning of the list.
+        ConstIterator begin() const noexcept {
+            return list.cbegin();
+        }
+
+        // Returns an iterator to the end of the list.
+        ConstIterator end() const noexcept {
+            return list.cend();
+        }
+
+    private:
+        enum op : unsigned char {
+            op_push_front = 1,
+            op_pop_front,
+            op_remove,
+            op_splice_after,
+            op_clear
+        };
+
+        static constexpr std::uint32_t log_magic = 0x57'4c'54'41; // "ATLW"
+        static constexpr std::uint32_t snapshot_magic = 0x53'4c'54'41; // "ATLS"
+        static constexpr std::size_t log_header_size = 16; // Magic, unused, generation.
+        static constexpr std::size_t snapshot_header_size = 24; // Magic, checksum, generation, count.
+
+        List list;
+        std::string base; // Path of the list; the files are base.snap and base.log.
+        durability_options opts;
+        std::uint64_t generation{0}; // Generation of the snapshot the log applies to.
+        int log_fd{-1};
+        std::mutex io; // Serializes writes to the files; taken before mutex when both are held.
+        off_t log_end{0}; // End of the last complete record on disk; guarded by io.
+        std::vector<unsigned char> writing; // Group being written; guarded by io.
+        std::exception_ptr flush_error; // First failure of the flusher, rethrown by commit(); guarded by io.
+        std::mutex mutex; // Guards the buffered records and the flusher state below.
+        std::vector<unsigned char> pending; // Records not written yet.
+        std::size_t pending_records{0};
+        std::chrono::steady_clock::time_point group_start; // When the first pending record was buffered.
+        bool stopping{false};
+        std::condition_variable wake; // Signals the flusher that a group started or that it must stop.
+        std::thread flusher; // Commits a group once its first record has waited group_delay.
+
+        // Buffers a record, [size][op][payload][checksum], and commits once the group is full.
+        void log(op code, const void* payload, std::size_t bytes) {
+            std::uint32_t size = static_cast<std::uint32_t>(1 + bytes);
+            bool full;
+            bool first;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                std::size_t at = pending.size();
+                pending.resize(at + 4 + size + 4);
+                unsigned char* p = pending.data() + at;
+                std::memcpy(p, &size, 4);
+                p[4] = code;
+                if (bytes) std::memcpy(p + 5, payload, bytes);
+                std::uint32_t sum = detail::checksum(p + 4, size);
+                std::memcpy(p + 4 + size, &sum, 4);
+                first = pending_records++ == 0;
+                if (first) group_start = std::chrono::steady_clock::now();
+                full = pending_records >= opts.group_commit || opts.group_delay.count() <= 0;
+            }
+            if (full) {
+                commit();
+            } else if (first) {
+                wake.notify_one();
+            }
+        }
+
+        // Writes and syncs the buffered records; io must be held.
+        void write_pending() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (pending.empty()) return;
+                writing.swap(pending);
+                pending_records = 0;
+            }
+            detail::write_fully(log_fd, writing.data(), writing.size(), log_end, "atl::durable_forward_list: write log");
+            log_end += static_cast<off_t>(writing.size());
+            writing.clear();
+            sync(log_fd, "atl::durable_forward_list: sync log");
+        }
+
+        // Runs on the flusher thread: commits each group once its first record has waited group_delay.
+        void flush_loop() {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (!stopping) {
+                if (pending_records == 0) {
+                    wake.wait(lock);
+                } else if (std::chrono::steady_clock::now() < group_start + opts.group_delay) {
+                    wake.wait_until(lock, group_start + opts.group_delay);
+                } else {
+                    lock.unlock();
+                    {
+                        std::lock_guard<std::mutex> io_lock(io);
+                        try {
+                            write_pending();
+                        } catch (...) {
+                            if (!flush_error) flush_error = std::current_exception();
+                        }
+                    }
+                    lock.lock();
+                }
+            }
+        }
+
+        // Writes the whole list to a new snapshot and starts an empty log; io must be held.
+        void take_snapshot() {
+            std::vector<unsigned char> out;
+            std::uint64_t count = 0;
+            out.resize(snapshot_header_size);
+            for (const Type& value : list) {
+                const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&value);
+                out.insert(out.end(), bytes, bytes + sizeof(Type));
+                ++count;
+            }
+            std::uint64_t next = generation + 1;
+            std::uint32_t sum = detail::checksum(out.data() + snapshot_header_size, out.size() - snapshot_header_size);
+            std::memcpy(out.data(), &snapshot_magic, 4);
+            std::memcpy(out.data() + 4, &sum, 4);
+            std::memcpy(out.data() + 8, &next, 8);
+            std::memcpy(out.data() + 16, &count, 8);
+
+            std::string tmp = base + ".snap.tmp";
+            int fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+            if (fd < 0) throw std::system_error(errno, std::generic_category(), "atl::durable_forward_list: create snapshot");
+            try {
+                detail::write_fully(fd, out.data(), out.size(), 0, "atl::durable_forward_list: write snapshot");
+                sync(fd, "atl::durable_forward_list: sync snapshot");
+            } catch (...) {
+                ::close(fd);
+                throw;
+            }
+            ::close(fd);
+            if (::rename(tmp.c_str(), (base + ".snap").c_str()) != 0) {
+                throw std::system_error(errno, std::generic_category(), "atl::durable_forward_list: rename snapshot");
+            }
+            sync_directory();
+            generation = next;
+            {
+                // Buffered records are already part of the snapshot.
+                std::lock_guard<std::mutex> lock(mutex);
+                pending.clear();
+                pending_records = 0;
+            }
+            reset_log();
+        }
+
+        // Applies a record read back from the log; returns false if it is malformed.
+        bool apply(const unsigned char* p, std::size_t size) {
+            op code = static_cast<op>(p[0]);
+            const unsigned char* payload = p + 1;
+            std::size_t bytes = size - 1;
+            Type value;
+            switch (code) {
+            case op_push_front:
+                if (bytes != sizeof(Type)) return false;
+                std::memcpy(&value, payload, sizeof(Type));
+                list.push_front(value);
+                return true;
+            case op_pop_front:
+                list.pop_front();
+                return true;
+            case op_remove:
+                if (bytes != sizeof(Type)) return false;
+                std::memcpy(&value, payload, sizeof(Type));
+                list.remove(value);
+                return true;
+            case op_splice_after: {
+                if (bytes < sizeof(std::uint64_t) || (bytes - sizeof(std::uint64_t)) % sizeof(Type) != 0) return false;
+                std::uint64_t where;
+                std::memcpy(&where, payload, sizeof(where));
+                std::vector<Type> values((bytes - sizeof(where)) / sizeof(Type));
+                if (!values.empty()) std::memcpy(values.data(), payload + sizeof(where), values.size() * sizeof(Type));
+                List moved(values.begin(), values.end(), list.get_allocator());
+                list.splice_after(position(static_cast<size_t>(where)), moved);
+                return true;
+            }
+            case op_clear:
+                list.clear();
+                return true;
+            }
+            return false;
+        }
+
+        // Returns an iterator to the element at position pos, which must exist.
+        typename List::Iterator position(size_t pos) {
+            auto it = list.begin();
+            for (; pos > 0; --pos) ++it;
+            return it;
+        }
+
+        // Loads base.snap, if it exists, into the empty list.
+        void load_snapshot() {
+            int fd = ::open((base + ".snap").c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) {
+                if (errno == ENOENT) return;
+                throw std::system_error(errno, std::generic_category(), "atl::durable_forward_list: open snapshot");
+            }
+            struct stat st;
+            std::vector<unsigned char> in;
+            try {
+                if (::fstat(fd, &st) != 0) throw std::system_error(errno, std::generic_category(), "atl::durable_forward_list: stat snapshot");
+                in.resize(static_cast<std::size_t>(st.st_size));
+                detail::read_fully(fd, in.data(), in.size(), 0, "atl::durable_forward_list: read snapshot");
+            } catch (...) {
+                ::close(fd);
+                throw;
+            }
+            ::close(fd);
+            std::uint32_t magic, sum;
+            std::uint64_t count;
+            if (in.size() < snapshot_header_size) throw std::runtime_error("atl::durable_forward_list: snapshot is truncated");
+            std::memcpy(&magic, in.data(), 4);
+            std::memcpy(&sum, in.data() + 4, 4);
+            std::memcpy(&generation, in.data() + 8, 8);
+            std::memcpy(&count, in.data() + 16, 8);
+            if (magic != snapshot_magic || in.size() != snapshot_header_size + count * sizeof(Type) ||
+                sum != detail::checksum(in.data() + snapshot_header_size, in.size() - snapshot_header_size)) {
+                throw std::runtime_error("atl::durable_forward_list: snapshot is corrupt");
+            }
+            std::vector<Type> values(count);
+            if (count) std::memcpy(values.data(), in.data() + snapshot_header_size, count * sizeof(Type));
+            list.assign(values.begin(), values.end());
+        }
+
+        // Opens base.log and replays it if it belongs to the loaded snapshot; otherwise starts a new log.
+        void open_log() {
+            log_fd = ::open((base + ".log").c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+            if (log_fd < 0) throw std::system_error(errno, std::generic_category(), "atl::durable_forward_list: open log");
+            struct stat st;
+            if (::fstat(log_fd, &st) != 0) throw std::system_error(errno, std::generic_category(), "atl::durable_forward_list: stat log");
+            std::vector<unsigned char> in(static_cast<std::size_t>(st.st_size));
+            detail::read_fully(log_fd, in.data(), in.size(), 0, "atl::durable_forward_list: read log");
+            std::uint32_t magic = 0;
+            std::uint64_t log_generation = 0;
+            if (in.size() >= log_header_size) {
+                std::memcpy(&magic, in.data(), 4);
+                std::memcpy(&log_generation, in.data() + 8, 8);
+            }
+            if (magic != log_magic || log_generation != generation) {
+                reset_log();
+                return;
+            }
+            std::size_t at = log_header_size;
+            while (in.size() - at >= 4) {
+                std::uint32_t size, sum;
+                std::memcpy(&size, in.data() + at, 4);
+                if (size == 0 || in.size() - at - 4 < std::size_t(size) + 4) break;
+                std::memcpy(&sum, in.data() + at + 4 + size, 4);
+                if (sum != detail::checksum(in.data() + at + 4, size) || !apply(in.data() + at + 4, size)) break;
+                at += 4 + size + 4;
+            }
+            // Drop a torn tail so that new records follow the last complete one.
+            log_end = static_cast<off_t>(at);
+            if (at != in.size()) {
+                if (::ftruncate(log_fd, log_end) != 0) throw std::system_error(errno, std::generic_category(), "atl::durable_forward_list: truncate log");
+                sync(log_fd, "atl::durable_forward_list: sync log");
+            }
+        }
+
+        // Empties the log and stamps it with the current generation.
+        void reset_log() {
+            unsigned char header[log_header_size] = {};
+            std::memcpy(header, &log_magic, 4);
+            std::memcpy(header + 8, &generation, 8);
+            if (::ftruncate(log_fd, 0) != 0) throw std::system_error(errno, std::generic_category(), "atl::durable_forward_list: truncate log");
+            detail::write_fully(log_fd, header, sizeof(header), 0, "atl::durable_forward_list: write log");
+            sync(log_fd, "atl::durable_forward_list: sync log");
+            log_end = static_cast<off_t>(log_header_size);
+        }
+
+        static void sync(int fd, const char* what) {
+            if (::fdatasync(fd) != 0) throw std::system_error(errno, std::generic_category(), what);
+        }
+
+        // Syncs the directory holding the files, so that the snapshot rename survives a crash.
+        void sync_directory() {
+            std::string::size_type slash = base.rfind('/');
+            std::string dir = slash == std::string::npos ? "." : slash == 0 ? "/" : base.substr(0, slash);
+            int fd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+            if (fd < 0) throw std::system_error(errno, std::generic_category(), "atl::durable_forward_list: open directory");
+            int rc = ::fsync(fd);
+            int err = errno;
+            ::close(fd);
+            if (rc != 0) throw std::system_error(err, std::generic_category(), "atl::durable_forward_list: sync directory");
+        }
+    };
+
+} // namespace atl
+
+#endif // DURABLE_FORWARD_LIST_H
@@ -0,0 +1,27 @@
+// Forward List Instantiations (atl::forward_list)
+
+/*
+    Explicit instantiations of atl::forward_list for common element types, built as the
+    atl_forward_list library target. Targets linking it are compiled with
+    ATL_FORWARD_LIST_USE_LIBRARY, so the hot paths are compiled, optimized and profiled
+    once instead of in every translation unit.
+*/
+
+#include "forward_list.tpp"
+#include <cstdint>
+#include <string>
+
+namespace atl {
+
+    template class forward_list_base<int>;
+    template class forward_list<int>;
+    template class forward_list_base<std::int64_t>;
+    template class forward_list<std::int64_t>;
+    template class forward_list_base<double>;
+    template class forward_list<double>;
+    template class forward_list_base<std::string>;
+    template class forward_list<std::string>;
+    template class forward_list_base<void*>;
+    template class forward_list<void*>;
+
+} // namespace atl
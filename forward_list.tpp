@@ -7,31 +7,118 @@
 #ifndef FORWARD_LIST_H
 #define FORWARD_LIST_H
 
-#include "Allocator.h"
+#include "allocator.h"
+#include "fwd_chain.h"
+#include "fwd_list_probes.h"
 #include <memory>
 #include <cstddef>
 #include <utility>
-#include <iostream>
+#include <functional>
+#include <type_traits>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <unordered_set>
+#include <stdexcept>
+#include <string>
+
+// Streaming builds write nodes with non-temporal stores where the target has them (x86-64).
+#if defined(__x86_64__) && defined(__SSE2__)
+#include <emmintrin.h>
+#define ATL_FWD_LIST_HAS_STREAM 1
+#else
+#define ATL_FWD_LIST_HAS_STREAM 0
+#endif
 
 namespace atl {
 
+    namespace detail {
+
+        // Detects comparators that declare is_transparent and so accept keys of any comparable type.
+        template<typename Compare, typename = void>
+        struct is_transparent : std::false_type {};
+
+        template<typename Compare>
+        struct is_transparent<Compare, std::void_t<typename Compare::is_transparent>> : std::true_type {};
+
+        template<typename Compare>
+        inline constexpr bool is_transparent_v = is_transparent<Compare>::value;
+
+        // Detects element types usable as std::unordered_set keys.
+        template<typename T, typename = void>
+        struct is_hashable : std::false_type {};
+
+        template<typename T>
+        struct is_hashable<T, std::void_t<decltype(std::hash<T>()(std::declval<const T&>()))>>
+            : std::is_default_constructible<std::hash<T>> {};
+
+        // Detects element types ordered by operator<.
+        template<typename T, typename = void>
+        struct is_less_comparable : std::false_type {};
+
+        template<typename T>
+        struct is_less_comparable<T, std::void_t<decltype(std::declval<const T&>() < std::declval<const T&>())>>
+            : std::true_type {};
+
+        // Copies bytes (a multiple of 8) from src to the 8-byte aligned dst with non-temporal stores, bypassing the cache.
+        inline void stream_copy(void* dst, const void* src, std::size_t bytes) noexcept {
+#if ATL_FWD_LIST_HAS_STREAM
+            long long* out = static_cast<long long*>(dst);
+            const unsigned char* in = static_cast<const unsigned char*>(src);
+            for (std::size_t i = 0; i < bytes / 8; ++i) {
+                long long word;
+                std::memcpy(&word, in + 8 * i, 8);
+                _mm_stream_si64(out + i, word);
+            }
+#else
+            std::memcpy(dst, src, bytes);
+#endif
+        }
+
+        // Orders earlier non-temporal stores before any later store, so that the written nodes can be handed to another thread.
+        inline void stream_fence() noexcept {
+#if ATL_FWD_LIST_HAS_STREAM
+            _mm_sfence();
+#endif
+        }
+
+    } // namespace detail
+
+    // Tag selecting the streaming build of a list, whose nodes are written with non-temporal stores. It pays off
+    // with an allocator that hands out nodes back to back, such as atl::pool_allocator; with malloc-style
+    // allocators the headers between nodes leave every cache line partly streamed, which is several times slower.
+    struct streaming_build_t {
+        explicit streaming_build_t() = default;
+    };
+
+    inline constexpr streaming_build_t streaming_build{};
+
+    // Bit i is set by a block predicate when the i-th value of the block satisfies it.
+    using fwd_list_block_mask = std::uint64_t;
+
+    // Number of values handed to a block predicate at once.
+    inline constexpr std::size_t fwd_list_block_size = 64;
+
     /*
         Node (atl::fwd_list_node)
         This struct defines a node in the singly linked list:
     */
     template<typename Type>
-    struct fwd_list_node {
+    struct fwd_list_node : detail::fwd_link_base {
 
         
-        Type value; // Type value: Stores the value of the node.
-        fwd_list_node* next{nullptr}; // fwd_list_node next*: Pointer to the next node in the list.
+        Type value; // Type value: Stores the value of the node; the link to the next node lives in detail::fwd_link_base.
 
         // Default constructor.
         fwd_list_node() = default; 
 
         // Move constructor.
         fwd_list_node(fwd_list_node&& x) noexcept 
-            : next(x.next), value(std::move(x.value)) {
+            : detail::fwd_link_base{x.next}, value(std::move(x.value)) {
             x.next = nullptr;
         }
 
@@ -52,15 +139,18 @@ namespace atl {
 
     /* 
         Iterator (atl::fwd_list_iterator)
-        This struct defines an iterator for traversing the singly linked list:
+        This struct defines an iterator for traversing the singly linked list;
+        NodeType lets other node layouts (e.g. atl::fwd_list_hashed_node) reuse it:
     */
-    template<typename Type>
+    template<typename Type, typename NodeType = fwd_list_node<Type>>
     struct fwd_list_iterator {
 
-        using iterator = fwd_list_iterator<Type>;
-        using const_iterator = fwd_list_iterator<const Type>;
-        using Node = fwd_list_node<Type>;
+        using iterator = fwd_list_iterator<Type, NodeType>;
+        using const_iterator = fwd_list_iterator<const Type, const NodeType>;
+        using Node = NodeType;
 
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
         using value_type = Type;
         using pointer = Type*;
         using reference = Type&;
@@ -82,14 +172,14 @@ namespace atl {
         
         // Pre-increment operator to move the iterator to the next node.
         iterator& operator++() {
-            node = node->next;
+            node = static_cast<Node*>(node->next);
             return *this;
         }
 
         // Post-increment operator to move the iterator to the next node.
         iterator operator++(int) {
             iterator tmp = *this;
-            node = node->next;
+            node = static_cast<Node*>(node->next);
             return tmp;
         }
 
@@ -114,10 +204,16 @@ namespace atl {
     class forward_list_base {
     protected:
         using Node = fwd_list_node<Type>;
+        using Link = detail::fwd_link_base;
+        using Chain = detail::fwd_chain;
 
-        Node* head; // Pointer to the head node of the list.
+        Link* head; // Pointer to the head node of the list.
         Allocator alloc; // Allocator used to allocate and deallocate memory for nodes.
         typename std::allocator_traits<Allocator>::template rebind_alloc<Type> value_alloc; // Rebound allocator for the type Type
+        Node* finger{nullptr}; // Node last reached by non-const positional access, or nullptr when unknown.
+        size_t finger_index{0}; // Position of finger in the list.
+        Link* spare{nullptr}; // Chain of reserved, pre-faulted node slots handed out before asking alloc.
+        size_t spare_count{0}; // Number of slots in spare.
 
     public:
         // Constructor initializing the base with the given allocator.
@@ -125,30 +221,84 @@ namespace atl {
         : head(nullptr), alloc(a), value_alloc(typename std::allocator_traits<Allocator>::template rebind_alloc<Type>(a)) {}
         
        
-        // Destructor that clears the list.
+        // Destructor that clears the list and frees the reserve.
         ~forward_list_base() {
             clear();
+            release_reserve();
         }
 
         // Move constructor.
         forward_list_base(forward_list_base&& other) noexcept
             : head(other.head), alloc(std::move(other.alloc)) {
             other.head = nullptr;
+            other.invalidate_finger();
+            take_reserve(other);
         }
 
         // Move assignment operator.
         forward_list_base& operator=(forward_list_base&& other) noexcept {
             if (this != &other) {
                 clear();
+                release_reserve();
                 head = other.head;
                 alloc = std::move(other.alloc);
                 other.head = nullptr;
+                other.invalidate_finger();
+                take_reserve(other);
             }
             return *this;
         }
 
-        // Allocates memory for a new node.
+        // Allocates and pre-faults node slots until at least n are held in reserve, so that a later burst of
+        // insertions takes its nodes from the reserve without calling the allocator or touching fresh pages.
+        void reserve_nodes(size_t n) {
+            while (spare_count < n) {
+                Node* node = alloc.allocate(1);
+                std::memset(static_cast<void*>(node), 0, sizeof(Node));
+                spare = ::new(static_cast<void*>(node)) Link{spare};
+                ++spare_count;
+            }
+        }
+
+        // Returns the reserved node slots to the allocator.
+        void release_reserve() noexcept {
+            while (spare) {
+                Node* node = as_node(Chain::unlink(&spare));
+                alloc.deallocate(node, 1);
+            }
+            spare_count = 0;
+        }
+
+        // Returns the number of node slots currently held in reserve.
+        size_t reserved_nodes() const noexcept {
+            return spare_count;
+        }
+
+        // Takes over the reserve of other, which was allocated by the allocator just moved from it. This reserve must
+        // already be empty: it has to be released through the allocator that was replaced.
+        void take_reserve(forward_list_base& other) noexcept {
+            spare = other.spare;
+            spare_count = other.spare_count;
+            other.spare = nullptr;
+            other.spare_count = 0;
+        }
+
+        // Returns the node containing link.
+        static Node* as_node(Link* link) noexcept {
+            return static_cast<Node*>(link);
+        }
+
+        // Forgets the positional access finger; called by every operation that relinks nodes.
+        void invalidate_finger() noexcept {
+            finger = nullptr;
+        }
+
+        // Allocates memory for a new node, from the reserve when it holds any.
         Node* allocate_node() {
+            if (spare) {
+                --spare_count;
+                return as_node(Chain::unlink(&spare));
+            }
             return static_cast<Node*>(alloc.allocate(1));
         }
 
@@ -158,18 +308,13 @@ namespace atl {
         }
 
          // Clears the list by destroying all nodes.
-        void clear() {
-            while (this->head) {
-                Node* tmp = this->head;
-                this->head = this->head->next;
-                this->destroy_node(tmp);
-            }
-        }
+        void clear();
 
         // Creates a new node with the given value.
         Node* create_node(const Type& value) {
             Node* node = allocate_node();                 
             std::allocator_traits<decltype(value_alloc)>::construct(value_alloc, &node->value, value); 
+            ATL_FWD_LIST_PROBE2(create_node, this, node);
             return node;
         }
 
@@ -177,17 +322,34 @@ namespace atl {
         Node* create_node(Type&& value) {
             Node* node = allocate_node();
             std::allocator_traits<decltype(value_alloc)>::construct(value_alloc, &node->value, std::move(value));
+            ATL_FWD_LIST_PROBE2(create_node, this, node);
             return node;
         }
 
         // Destroys the given node and deallocates its memory.
         void destroy_node(Node* node) {
+            ATL_FWD_LIST_PROBE2(destroy_node, this, node);
             std::allocator_traits<decltype(value_alloc)>::destroy(value_alloc, &node->value);
             deallocate_node(node);
         }
     
     };
 
+    // Members defined outside the class are not implicitly inline, so the extern templates at the end of
+    // this file keep translation units from instantiating them again.
+    template<typename Type, typename Allocator>
+    void forward_list_base<Type, Allocator>::clear() {
+        invalidate_finger();
+        size_t removed = 0;
+        while (this->head) {
+            Node* tmp = as_node(this->head);
+            this->head = this->head->next;
+            this->destroy_node(tmp);
+            ++removed;
+        }
+        ATL_FWD_LIST_PROBE2(clear, this, removed);
+    }
+
     /*
         Forward List Class (atl::forward_list)
         This class provides the interface for the forward list, 
@@ -198,8 +360,11 @@ namespace atl {
     public:
         using Base = forward_list_base<Type, Allocator>;
         using Node = fwd_list_node<Type>;
+        using Link = typename Base::Link;
+        using Chain = typename Base::Chain;
+        using Base::as_node;
         using Iterator = fwd_list_iterator<Type>;
-        using ConstIterator = fwd_list_iterator<const Type>;
+        using ConstIterator = fwd_list_iterator<const Type, const Node>;
 
         // Constructor initializing the list with the given allocator.
         forward_list(const Allocator& a = Allocator()) noexcept
@@ -210,11 +375,27 @@ namespace atl {
 
         // Copy constructor.
         forward_list(const forward_list& other) : Base(other.alloc) {
-            for (Node* current = other.head; current; current = current->next) {
+            for (Node* current = as_node(other.head); current; current = as_node(current->next)) {
                 push_front(current->value);
             }
         }
 
+        // Constructor building the list from the range [first, last), in order.
+        template<std::input_iterator InputIt>
+        forward_list(InputIt first, InputIt last, const Allocator& a = Allocator())
+            : Base(a) {
+            build(first, last);
+        }
+
+        // Constructor building the list from the range [first, last), in order, with non-temporal stores.
+        // Meant for huge write-once lists handed to another thread or written out: the nodes do not
+        // pass through the cache, so the build does not evict the caller's working set.
+        template<std::input_iterator InputIt>
+        forward_list(streaming_build_t, InputIt first, InputIt last, const Allocator& a = Allocator())
+            : Base(a) {
+            build_streaming(first, last);
+        }
+
         // Move constructor.
         forward_list(forward_list&& other) noexcept
             : Base(std::move(other)) {}
@@ -223,7 +404,7 @@ namespace atl {
         forward_list& operator=(const forward_list& other) {
             if (this != &other) {
                 forward_list_base<Type, Allocator>::clear();
-                for (Node* current = other.head; current; current = current->next) {
+                for (Node* current = as_node(other.head); current; current = as_node(current->next)) {
                     push_front(current->value);
                 }
             }
@@ -234,9 +415,12 @@ namespace atl {
         forward_list& operator=(forward_list&& other) noexcept {
             if (this != &other) {
                 forward_list_base<Type, Allocator>::clear();
+                this->release_reserve();
                 this->head = other.head;
                 this->alloc = std::move(other.alloc);
                 other.head = nullptr;
+                other.invalidate_finger();
+                this->take_reserve(other);
             }
             return *this;
         }
@@ -249,6 +433,20 @@ namespace atl {
             }
         }
 
+        // Replaces the contents with the range [first, last), in order.
+        template<std::input_iterator InputIt>
+        void assign(InputIt first, InputIt last) {
+            forward_list_base<Type, Allocator>::clear();
+            build(first, last);
+        }
+
+        // Replaces the contents with the range [first, last), in order, with non-temporal stores.
+        template<std::input_iterator InputIt>
+        void assign(streaming_build_t, InputIt first, InputIt last) {
+            forward_list_base<Type, Allocator>::clear();
+            build_streaming(first, last);
+        }
+
         // Returns the allocator used by the list.
         Allocator get_allocator() const noexcept {
             return this->alloc;
@@ -256,12 +454,41 @@ namespace atl {
 
         // Returns the allocator used by the list.
         Type& front() {
-            return this->head->value;
+            return as_node(this->head)->value;
         }
         
         // Returns a constant reference to the first element in the list.
         const Type& front() const {
-            return this->head->value;
+            return as_node(this->head)->value;
+        }
+
+        // Returns a reference to the element at position pos, throwing std::out_of_range past the end.
+        // Positional access resumes from the last position reached when pos is not before it,
+        // so visiting positions in increasing order costs O(n) in total.
+        Type& at(size_t pos) {
+            Node* node = seek(pos);
+            if (!node) throw std::out_of_range("atl::forward_list::at");
+            return node->value;
+        }
+
+        // Returns a constant reference to the element at position pos, throwing std::out_of_range past the end.
+        // This resumes from the last position reached by non-const access but never moves it, so concurrent
+        // const access to a shared list is safe; an increasing scan through it costs O(pos) per call.
+        const Type& at(size_t pos) const {
+            const Node* node = find_position(pos);
+            if (!node) throw std::out_of_range("atl::forward_list::at");
+            return node->value;
+        }
+
+        // Returns a reference to the element at position pos, which must exist.
+        Type& operator[](size_t pos) {
+            return seek(pos)->value;
+        }
+
+        // Returns a constant reference to the element at position pos, which must exist; like const at(),
+        // it does not move the position it resumes from.
+        const Type& operator[](size_t pos) const {
+            return find_position(pos)->value;
         }
 
         // Checks if the list is empty.
@@ -272,15 +499,15 @@ namespace atl {
         // Inserts a new element at the front of the list.
         void push_front(const Type& value) {
             Node* new_node = this->create_node(value);
-            new_node->next = this->head;
-            this->head = new_node;
+            Chain::link_front(&this->head, new_node);
+            ++this->finger_index;
         }
         
         // Inserts a new element at the front of the list, moving the value.
         void push_front(Type&& value) {
             Node* new_node = this->create_node(std::move(value));
-            new_node->next = this->head;
-            this->head = new_node;
+            Chain::link_front(&this->head, new_node);
+            ++this->finger_index;
         }
 
         // Constructs and inserts a new element at the front of the list with the given arguments.
@@ -288,132 +515,499 @@ namespace atl {
         void emplace_front(Args&&... args) {
             Node* new_node = this->allocate_node();
             this->alloc.construct(&new_node->value, std::forward<Args>(args)...);
-            new_node->next = this->head;
-            this->head = new_node;
+            Chain::link_front(&this->head, new_node);
+            ++this->finger_index;
         }
 
         // Removes the first element from the list.
         void pop_front() {
             if (this->head) {
-                Node* tmp = this->head;
+                Node* tmp = as_node(this->head);
+                if (this->finger == tmp) {
+                    this->invalidate_finger();
+                } else {
+                    --this->finger_index;
+                }
                 this->head = this->head->next;
                 this->destroy_node(tmp);
             }
         }
 
         // Resizes the list to contain count elements, filling with value if necessary.
-        void resize(size_t count, const Type& value = Type()) {
-            size_t current_size = 0;
-            for (Node* current = this->head; current; current = current->next) {
-                ++current_size;
-            }
-            if (count < current_size) {
-                while (count < current_size) {
-                    pop_front();
-                    --current_size;
-                }
-            } else if (count > current_size) {
-                while (count > current_size) {
-                    push_front(value);
-                    ++current_size;
-                }
-            }
-        }
+        void resize(size_t count, const Type& value = Type());
 
         // Swaps the contents of this list with other.
         void swap(forward_list& other) noexcept {
+            this->invalidate_finger();
+            other.invalidate_finger();
             std::swap(this->head, other.head);
             std::swap(this->alloc, other.alloc);
+            std::swap(this->spare, other.spare);
+            std::swap(this->spare_count, other.spare_count);
         }
 
         // Merges other list into this one, assuming both are sorted.
-        void merge(forward_list& other) {
-            Node** pos = &this->head;
-            while (*pos && other.head) {
-                if ((*pos)->value < other.head->value) {
-                    pos = &(*pos)->next;
-                } else {
-                    Node* temp = other.head;
-                    other.head = other.head->next;
-                    temp->next = *pos;
-                    *pos = temp;
-                }
-            }
-            if (other.head) {
-                *pos = other.head;
-                other.head = nullptr;
+        // The probe counts both lists, which only adds a linear pass while a tracer is attached.
+        void merge(forward_list& other);
+
+        // Merges other list into this one, assuming both are sorted by the arithmetic key key(value).
+        // The next node is chosen with conditional moves rather than a branch, which avoids
+        // mispredictions on randomly interleaved inputs. On equal keys, elements of other come first.
+        // On nearly sorted inputs, whose long runs merge predicts well, it is slower than merge (see
+        // bench/merge_bench.cpp), so it is used only when the caller knows the inputs interleave.
+        template<typename KeyFn>
+        void merge_by_key(forward_list& other, KeyFn key) {
+            this->invalidate_finger();
+            other.invalidate_finger();
+            static_assert(std::is_arithmetic_v<std::decay_t<std::invoke_result_t<KeyFn&, const Type&>>>,
+                          "merge_by_key requires an arithmetic key");
+            Node* a = as_node(this->head);
+            Node* b = as_node(other.head);
+            Link* result = nullptr;
+            Link** tail = &result;
+            // The selects are done with masks on the pointer bits; written as ?: they compile to a branch.
+            while (a && b) {
+                const std::uintptr_t mask = std::uintptr_t(0) - std::uintptr_t(!(key(a->value) < key(b->value)));
+                const std::uintptr_t ua = reinterpret_cast<std::uintptr_t>(a);
+                const std::uintptr_t ub = reinterpret_cast<std::uintptr_t>(b);
+                Node* pick = reinterpret_cast<Node*>((ua & ~mask) | (ub & mask));
+                const std::uintptr_t next = reinterpret_cast<std::uintptr_t>(pick->next);
+                *tail = pick;
+                tail = &pick->next;
+                a = reinterpret_cast<Node*>((ua & mask) | (next & ~mask));
+                b = reinterpret_cast<Node*>((ub & ~mask) | (next & mask));
             }
+            *tail = a ? a : b;
+            this->head = result;
+            other.head = nullptr;
         }
 
         // Splices elements from other list into this list after the position pos.
         void splice_after(Iterator pos, forward_list& other) {
-            if (!other.head) return;
-            Node* last = other.head;
-            while (last->next) last = last->next;
-            last->next = pos.node->next;
-            pos.node->next = other.head;
+            if (ATL_FWD_LIST_PROBE_ENABLED(splice_after)) {
+                ATL_FWD_LIST_PROBE3(splice_after, this, &other, Chain::count(other.head));
+            }
+            this->invalidate_finger();
+            other.invalidate_finger();
+            Chain::splice_after(pos.node, other.head);
             other.head = nullptr;
         }
 
+        // Removes the element after pos and returns an iterator to the element that followed it.
+        Iterator erase_after(Iterator pos) {
+            this->invalidate_finger();
+            Node* node = as_node(Chain::unlink(&pos.node->next));
+            this->destroy_node(node);
+            return Iterator(as_node(pos.node->next));
+        }
+
+        // Removes the elements after pos up to, but not including, last, and returns last.
+        Iterator erase_after(Iterator pos, Iterator last) {
+            this->invalidate_finger();
+            while (pos.node->next != last.node) {
+                this->destroy_node(as_node(Chain::unlink(&pos.node->next)));
+            }
+            return last;
+        }
+
         // Removes all elements equal to value
-        void remove(const Type& value) {
-            Node** pos = &this->head;
-            while (*pos) {
-                if ((*pos)->value == value) {
-                    Node* temp = *pos;
-                    *pos = (*pos)->next;
-                    this->destroy_node(temp);
-                } else {
-                    pos = &(*pos)->next;
-                }
+        void remove(const Type& value);
+
+        // Removes all elements equal to key without constructing a Type (e.g. a std::string_view key for std::string elements).
+        template<typename K, typename Equal = std::equal_to<>,
+                 typename = std::enable_if_t<detail::is_transparent_v<Equal>>>
+        void remove(const K& key, Equal eq = Equal()) {
+            remove_if([&](const Type& value) { return eq(value, key); });
+        }
+
+        // Returns an iterator to the first element equal to key, or end() if there is none.
+        template<typename K, typename Equal = std::equal_to<>,
+                 typename = std::enable_if_t<detail::is_transparent_v<Equal>>>
+        Iterator find(const K& key, Equal eq = Equal()) {
+            Node* current = as_node(this->head);
+            while (current && !eq(current->value, key)) {
+                current = as_node(current->next);
+            }
+            return Iterator(current);
+        }
+
+        // Returns the number of elements equal to key.
+        template<typename K, typename Equal = std::equal_to<>,
+                 typename = std::enable_if_t<detail::is_transparent_v<Equal>>>
+        size_t count(const K& key, Equal eq = Equal()) const {
+            size_t n = 0;
+            for (Node* current = as_node(this->head); current; current = as_node(current->next)) {
+                if (eq(current->value, key)) ++n;
+            }
+            return n;
+        }
+
+        // Checks if the list contains an element equal to key.
+        template<typename K, typename Equal = std::equal_to<>,
+                 typename = std::enable_if_t<detail::is_transparent_v<Equal>>>
+        bool contains(const K& key, Equal eq = Equal()) const {
+            for (Node* current = as_node(this->head); current; current = as_node(current->next)) {
+                if (eq(current->value, key)) return true;
             }
+            return false;
         }
 
         // Removes all elements that satisfy the predicate pred.
+        // pred is either called per value, or, as pred(std::span<const Type>, fwd_list_block_mask&),
+        // once per block of up to fwd_list_block_size values so it can test them together.
         template<typename Predicate>
         void remove_if(Predicate pred) {
-            Node** pos = &this->head;
-            while (*pos) {
-                if (pred((*pos)->value)) {
-                    Node* temp = *pos;
-                    *pos = (*pos)->next;
-                    this->destroy_node(temp);
+            this->invalidate_finger();
+            Link** pos = &this->head;
+            size_t removed = 0;
+            evaluate(pred, [&](Node* node, bool hit) {
+                if (hit) {
+                    *pos = node->next;
+                    this->destroy_node(node);
+                    ++removed;
                 } else {
-                    pos = &(*pos)->next;
+                    pos = &node->next;
                 }
-            }
+            });
+            ATL_FWD_LIST_PROBE2(remove_if, this, removed);
+        }
+
+        // Relinks the elements satisfying pred in front of the others, keeping the relative order of both groups.
+        // Returns an iterator to the first element of the second group; pred may be a block predicate as in remove_if.
+        template<typename Predicate>
+        Iterator partition(Predicate pred) {
+            this->invalidate_finger();
+            Link* yes_head = nullptr;
+            Link* no_head = nullptr;
+            Link** yes_tail = &yes_head;
+            Link** no_tail = &no_head;
+            evaluate(pred, [&](Node* node, bool hit) {
+                if (hit) {
+                    *yes_tail = node;
+                    yes_tail = &node->next;
+                } else {
+                    *no_tail = node;
+                    no_tail = &node->next;
+                }
+            });
+            *no_tail = nullptr;
+            *yes_tail = no_head;
+            this->head = yes_head;
+            return Iterator(as_node(no_head));
         }
         
         // Reverses the order of elements in the list.
         void reverse() {
-            Node* prev = nullptr;
-            Node* current = this->head;
+            this->invalidate_finger();
+            this->head = Chain::reverse(this->head);
+        }
+
+        // Removes consecutive duplicate elements from the list.
+        void unique();
+
+        // Sorts the list in ascending order, keeping equal elements in their original order.
+        void sort();
+
+        // Sorts the list with comp using an adaptive natural merge sort: runs that are already
+        // ascending (or strictly descending, which are reversed by relinking) are detected in one pass,
+        // runs shorter than sort_min_run are extended by insertion sort, and runs are merged under
+        // TimSort's stack invariants. Sorted input takes O(n); the sort is stable and never allocates.
+        template<typename Compare>
+        void sort(Compare comp) {
+            this->invalidate_finger();
+            if (!this->head || !this->head->next) return;
+
+            struct run {
+                Link* head;
+                size_t length;
+            };
+            std::array<run, 85> stack; // Enough for any list under the invariants below.
+            size_t depth = 0;
+
+            Node* rest = as_node(this->head);
+            while (rest) {
+                Link* run_head = rest;
+                Node* run_tail = rest;
+                size_t length = 1;
+                rest = as_node(rest->next);
+
+                if (rest && comp(rest->value, as_node(run_head)->value)) {
+                    // Strictly descending run: relink each node in front of the run.
+                    run_tail->next = nullptr;
+                    while (rest && comp(rest->value, as_node(run_head)->value)) {
+                        Node* next = as_node(rest->next);
+                        Chain::link_front(&run_head, rest);
+                        rest = next;
+                        ++length;
+                    }
+                } else {
+                    while (rest && !comp(rest->value, run_tail->value)) {
+                        run_tail = rest;
+                        rest = as_node(rest->next);
+                        ++length;
+                    }
+                    run_tail->next = nullptr;
+                }
+
+                // Extend short runs by insertion sort.
+                while (rest && length < sort_min_run) {
+                    Node* node = rest;
+                    rest = as_node(rest->next);
+                    Link** pos = &run_head;
+                    while (*pos && !comp(node->value, as_node(*pos)->value)) {
+                        pos = &(*pos)->next;
+                    }
+                    Chain::link_front(pos, node);
+                    ++length;
+                }
+
+                stack[depth++] = run{run_head, length};
+
+                // Restore the invariants length[i-2] > length[i-1] + length[i] and length[i-1] > length[i].
+                while (depth > 1) {
+                    size_t n = depth - 2;
+                    if ((n > 0 && stack[n - 1].length <= stack[n].length + stack[n + 1].length) ||
+                        (n > 1 && stack[n - 2].length <= stack[n - 1].length + stack[n].length)) {
+                        if (stack[n - 1].length < stack[n + 1].length) --n;
+                    } else if (stack[n].length > stack[n + 1].length) {
+                        break;
+                    }
+                    merge_runs(stack.data(), depth, n, comp);
+                }
+            }
+
+            while (depth > 1) {
+                size_t n = depth - 2;
+                if (n > 0 && stack[n - 1].length < stack[n + 1].length) --n;
+                merge_runs(stack.data(), depth, n, comp);
+            }
+            this->head = stack[0].head;
+        }
+
+        // Relinks the k smallest elements, in ascending order by comp, to the front of the list.
+        // A bounded max-heap of node pointers holds the candidates; the other elements follow in unspecified order.
+        template<typename Compare = std::less<>>
+        void partial_sort(size_t k, Compare comp = Compare()) {
+            this->invalidate_finger();
+            if (k == 0 || !this->head) return;
+            auto node_comp = [&comp](const Node* a, const Node* b) { return comp(a->value, b->value); };
+            std::vector<Node*> heap;
+            heap.reserve(std::min<size_t>(k, 4096));
+
+            Link* rest = nullptr;
+            Link** rest_tail = &rest;
+            Node* current = as_node(this->head);
             while (current) {
-                Node* next = current->next;
-                current->next = prev;
-                prev = current;
+                Node* next = as_node(current->next);
+                if (heap.size() < k) {
+                    heap.push_back(current);
+                    std::push_heap(heap.begin(), heap.end(), node_comp);
+                } else if (comp(current->value, heap.front()->value)) {
+                    std::pop_heap(heap.begin(), heap.end(), node_comp);
+                    Node* evicted = heap.back();
+                    heap.back() = current;
+                    std::push_heap(heap.begin(), heap.end(), node_comp);
+                    *rest_tail = evicted;
+                    rest_tail = &evicted->next;
+                } else {
+                    *rest_tail = current;
+                    rest_tail = &current->next;
+                }
                 current = next;
             }
-            this->head = prev;
+            *rest_tail = nullptr;
+
+            std::sort_heap(heap.begin(), heap.end(), node_comp);
+            Link** tail = &this->head;
+            for (Node* node : heap) {
+                *tail = node;
+                tail = &node->next;
+            }
+            *tail = rest;
         }
 
-        // Removes consecutive duplicate elements from the list.
-        void unique() {
-            Node* current = this->head;
-            while (current && current->next) {
-                if (current->value == current->next->value) {
-                    Node* temp = current->next;
-                    current->next = current->next->next;
-                    this->destroy_node(temp);
+        // Relinks the list so that the element at position n is the one that would be there if the list were sorted,
+        // no element before it is greater and no element after it is less. Quickselect over partitioned chains.
+        template<typename Compare = std::less<>>
+        void nth_element(size_t n, Compare comp = Compare()) {
+            this->invalidate_finger();
+            size_t length = Chain::count(this->head);
+            if (n >= length) return;
+
+            Link* front = nullptr; // Finished elements before the current chain.
+            Link** front_tail = &front;
+            Link* back = nullptr; // Finished elements after the current chain.
+            Node* current = as_node(this->head);
+            while (true) {
+                Node* pivot = as_node(Chain::advance(current, length / 2));
+
+                Link* lt_head = nullptr;
+                Link* eq_head = nullptr;
+                Link* gt_head = nullptr;
+                Link** lt_tail = &lt_head;
+                Link** eq_tail = &eq_head;
+                Link** gt_tail = &gt_head;
+                size_t lt_count = 0, eq_count = 0;
+                while (current) {
+                    Node* next = as_node(current->next);
+                    if (comp(current->value, pivot->value)) {
+                        *lt_tail = current;
+                        lt_tail = &current->next;
+                        ++lt_count;
+                    } else if (comp(pivot->value, current->value)) {
+                        *gt_tail = current;
+                        gt_tail = &current->next;
+                    } else {
+                        *eq_tail = current;
+                        eq_tail = &current->next;
+                        ++eq_count;
+                    }
+                    current = next;
+                }
+
+                if (n < lt_count) {
+                    *gt_tail = back;
+                    *eq_tail = gt_head;
+                    back = eq_head;
+                    *lt_tail = nullptr;
+                    current = as_node(lt_head);
+                    length = lt_count;
+                } else if (n < lt_count + eq_count) {
+                    *gt_tail = back;
+                    *eq_tail = gt_head;
+                    *lt_tail = eq_head;
+                    *front_tail = lt_head;
+                    break;
                 } else {
-                    current = current->next;
+                    *lt_tail = eq_head;
+                    *front_tail = lt_head;
+                    front_tail = eq_tail;
+                    *gt_tail = nullptr;
+                    current = as_node(gt_head);
+                    n -= lt_count + eq_count;
+                    length -= lt_count + eq_count;
                 }
             }
+            this->head = front;
+        }
+
+        // Relinks the k smallest elements by comp, in unspecified order, to the front of the list.
+        template<typename Compare = std::less<>>
+        void select_k(size_t k, Compare comp = Compare()) {
+            if (k > 0) nth_element(k - 1, comp);
+        }
+
+        // Moves the union of this sorted list and other into out, after its existing elements.
+        // Both inputs are left empty; of each pair of equal elements only the one from this list is kept.
+        template<typename Compare>
+        void set_union_into(forward_list& other, forward_list& out, Compare comp) {
+            set_operation_into(other, out, comp, true, true, true);
+        }
+
+        // Moves the elements of this sorted list that also occur in other into out; the rest are destroyed.
+        template<typename Compare>
+        void set_intersection_into(forward_list& other, forward_list& out, Compare comp) {
+            set_operation_into(other, out, comp, false, false, true);
+        }
+
+        // Moves the elements of this sorted list that do not occur in other into out; the rest are destroyed.
+        template<typename Compare>
+        void set_difference_into(forward_list& other, forward_list& out, Compare comp) {
+            set_operation_into(other, out, comp, true, false, false);
+        }
+
+        // Moves the elements occurring in exactly one of this sorted list and other into out; the rest are destroyed.
+        template<typename Compare>
+        void symmetric_difference_into(forward_list& other, forward_list& out, Compare comp) {
+            set_operation_into(other, out, comp, true, true, false);
+        }
+
+        // The set operations above ordered by operator<.
+        void set_union_into(forward_list& other, forward_list& out);
+        void set_intersection_into(forward_list& other, forward_list& out);
+        void set_difference_into(forward_list& other, forward_list& out);
+        void symmetric_difference_into(forward_list& other, forward_list& out);
+
+        // Removes every element equal to one of keys in a single pass over the list.
+        template<typename Range>
+        void remove_many(const Range& keys) {
+            with_key_matcher(keys, [this](auto& matches) { remove_if(matches); });
+        }
+
+        // Writes an iterator to every element equal to one of keys, in list order, to out, scanning the list once.
+        template<typename Range, typename OutputIt>
+        OutputIt find_many(const Range& keys, OutputIt out) {
+            with_key_matcher(keys, [this, &out](auto& matches) {
+                for (Node* current = as_node(this->head); current; current = as_node(current->next)) {
+                    if (matches(current->value)) *out++ = Iterator(current);
+                }
+            });
+            return out;
+        }
+
+        // Relinks every element onto the tail of outs[key(value)] in a single pass, keeping the order within each
+        // bucket. Elements whose key is not below outs.size() stay in this list; outs must not contain this list.
+        template<typename KeyFn>
+        void distribute(KeyFn key, std::span<forward_list> outs) {
+            std::array<Link**, distribute_inline_buckets> inline_tails;
+            std::vector<Link**> heap_tails;
+            Link*** tails = inline_tails.data();
+            if (outs.size() > distribute_inline_buckets) {
+                heap_tails.resize(outs.size());
+                tails = heap_tails.data();
+            }
+            this->invalidate_finger();
+            for (size_t i = 0; i < outs.size(); ++i) {
+                outs[i].invalidate_finger();
+                tails[i] = Chain::end_link(&outs[i].head);
+            }
+
+            Node* current = as_node(this->head);
+            this->head = nullptr;
+            Link** keep = &this->head;
+            while (current) {
+                Node* next = as_node(current->next);
+                const size_t bucket = static_cast<size_t>(key(current->value));
+                Link**& tail = bucket < outs.size() ? tails[bucket] : keep;
+                *tail = current;
+                tail = &current->next;
+                current = next;
+            }
+            for (size_t i = 0; i < outs.size(); ++i) {
+                *tails[i] = nullptr;
+            }
+            *keep = nullptr;
+        }
+
+        // Calls fn on every element in order.
+        template<typename Fn>
+        void for_each(Fn fn) {
+            walk([&fn](Node* node) { fn(node->value); return true; });
+        }
+
+        // Calls fn on every constant element in order.
+        template<typename Fn>
+        void for_each(Fn fn) const {
+            walk([&fn](const Node* node) { fn(node->value); return true; });
+        }
+
+        // Calls fn on elements in order until it returns false; returns an iterator to that element, or end().
+        template<typename Fn>
+        Iterator for_each_while(Fn fn) {
+            return Iterator(walk([&fn](Node* node) { return static_cast<bool>(fn(node->value)); }));
+        }
+
+        // Calls fn on every node in order. The next pointer of a node is read before fn sees it,
+        // so fn may relink or destroy the node as long as the list is repaired afterwards.
+        template<typename Fn>
+        void for_each_node(Fn fn) {
+            this->invalidate_finger();
+            walk([&fn](Node* node) { fn(node); return true; });
         }
 
         // Returns an iterator to the beginning of the list.
         Iterator begin() noexcept {
-            return Iterator(this->head);
+            return Iterator(as_node(this->head));
         }
 
         // Returns an iterator to the end of the list.
@@ -423,15 +1017,421 @@ namespace atl {
         
         // Returns a constant iterator to the beginning of the list.
         ConstIterator cbegin() const noexcept {
-            return ConstIterator(this->head);
+            return ConstIterator(as_node(this->head));
         }
 
         // Returns a constant iterator to the end of the list.
         ConstIterator cend() const noexcept {
             return ConstIterator(nullptr);
         }
+
+    private:
+        // Calls visit on nodes in order until it returns false; returns that node or nullptr.
+        // next is read before visit runs, so visit may relink the node it is given.
+        template<typename Visit>
+        Node* walk(Visit visit) const {
+            for (Node* current = as_node(this->head); current;) {
+                Node* next = as_node(current->next);
+                if (!visit(current)) return current;
+                current = next;
+            }
+            return nullptr;
+        }
+
+        // Returns the node at position pos, or nullptr past the end, starting from the finger when it is not beyond pos.
+        Node* find_position(size_t pos) const noexcept {
+            Node* current = as_node(this->head);
+            size_t index = 0;
+            if (this->finger && this->finger_index <= pos) {
+                current = this->finger;
+                index = this->finger_index;
+            }
+            while (current && index < pos) {
+                current = as_node(current->next);
+                ++index;
+            }
+            return current;
+        }
+
+        // Returns the node at position pos like find_position, and moves the finger to it.
+        Node* seek(size_t pos) noexcept {
+            Node* current = find_position(pos);
+            if (current) {
+                this->finger = current;
+                this->finger_index = pos;
+            }
+            return current;
+        }
+
+        // Appends the range [first, last) to the empty list, in order.
+        template<typename InputIt>
+        void build(InputIt first, InputIt last) {
+            Link** tail = &this->head;
+            try {
+                for (; first != last; ++first) {
+                    Chain::append(tail, this->create_node(*first));
+                }
+            } catch (...) {
+                *tail = nullptr;
+                throw;
+            }
+            *tail = nullptr;
+        }
+
+        // Appends the range [first, last) to the empty list with non-temporal stores. Each node is written
+        // whole, link included, once its successor is allocated, so no line is ever read back into the cache.
+        // Types that are not trivially copyable, and targets without such stores, use build.
+        template<typename InputIt>
+        void build_streaming(InputIt first, InputIt last) {
+            if constexpr (!ATL_FWD_LIST_HAS_STREAM || !std::is_trivially_copyable_v<Type> ||
+                          sizeof(Node) % 8 != 0 || alignof(Node) < 8) {
+                build(first, last);
+            } else {
+                if (first == last) return;
+                Type value = *first;
+                alignas(Node) unsigned char image[sizeof(Node)] = {};
+                Node* node = this->allocate_node();
+                Node* const front = node;
+                const size_t value_offset = reinterpret_cast<unsigned char*>(&node->value) - reinterpret_cast<unsigned char*>(node);
+                // Writes value into image and streams image, linked to next, into node.
+                auto stream = [&](Node* target, Link* next) {
+                    std::memcpy(image, &next, sizeof(next));
+                    detail::stream_copy(target, image, sizeof(Node));
+                };
+                std::memcpy(image + value_offset, &value, sizeof(Type));
+                // The head is only published once every node up to the last one reached has been streamed.
+                try {
+                    for (++first; first != last; ++first) {
+                        value = *first;
+                        Node* next = this->allocate_node();
+                        stream(node, next);
+                        node = next;
+                        std::memcpy(image + value_offset, &value, sizeof(Type));
+                    }
+                } catch (...) {
+                    stream(node, nullptr);
+                    detail::stream_fence();
+                    this->head = front;
+                    throw;
+                }
+                stream(node, nullptr);
+                detail::stream_fence();
+                this->head = front;
+            }
+        }
+
+        // Runs shorter than this are extended by insertion sort before merging.
+        static constexpr size_t sort_min_run = 16;
+
+        // Stably merges two sorted null-terminated chains and returns the head of the result.
+        template<typename Compare>
+        static Link* merge_chains(Link* a, Link* b, Compare& comp) {
+            Link* result = nullptr;
+            Link** tail = &result;
+            while (a && b) {
+                if (comp(as_node(b)->value, as_node(a)->value)) {
+                    Chain::append(tail, b);
+                    b = b->next;
+                } else {
+                    Chain::append(tail, a);
+                    a = a->next;
+                }
+            }
+            *tail = a ? a : b;
+            return result;
+        }
+
+        // Merges the runs at stack[i] and stack[i + 1] of a sort run stack holding depth runs.
+        template<typename Run, typename Compare>
+        static void merge_runs(Run* stack, size_t& depth, size_t i, Compare& comp) {
+            stack[i].head = merge_chains(stack[i].head, stack[i + 1].head, comp);
+            stack[i].length += stack[i + 1].length;
+            for (size_t j = i + 1; j + 1 < depth; ++j) {
+                stack[j] = stack[j + 1];
+            }
+            --depth;
+        }
+
+        // Bucket counts up to which distribute keeps its tail pointers on the stack.
+        static constexpr size_t distribute_inline_buckets = 64;
+
+        // Key counts from which remove_many and find_many index the keys in a hash set instead of a sorted array.
+        static constexpr size_t many_keys_hash_threshold = 64;
+
+        // Indexes pointers to keys and calls fn with a predicate testing a value for membership. Small key sets
+        // (or unhashable types) use a sorted array and binary search, larger ones a hash set. Keys are not copied
+        // when the range yields references to Type; keys of any other type are converted into owned storage first.
+        template<typename Range, typename Fn>
+        static void with_key_matcher(const Range& keys, Fn fn) {
+            using KeyRef = decltype(*std::begin(std::declval<const Range&>()));
+            std::vector<Type> owned;
+            std::vector<const Type*> index;
+            if constexpr (std::is_lvalue_reference_v<KeyRef> && std::is_same_v<std::remove_cvref_t<KeyRef>, Type>) {
+                for (const Type& key : keys) index.push_back(&key);
+            } else {
+                for (auto&& key : keys) owned.emplace_back(std::forward<decltype(key)>(key));
+                for (const Type& key : owned) index.push_back(&key);
+            }
+
+            if constexpr (detail::is_hashable<Type>::value) {
+                if (!detail::is_less_comparable<Type>::value || index.size() >= many_keys_hash_threshold) {
+                    auto hash = [](const Type* key) { return std::hash<Type>()(*key); };
+                    auto equal = [](const Type* a, const Type* b) { return *a == *b; };
+                    std::unordered_set<const Type*, decltype(hash), decltype(equal)> set(index.begin(), index.end(), index.size(), hash, equal);
+                    auto matches = [&set](const Type& value) { return set.find(&value) != set.end(); };
+                    fn(matches);
+                    return;
+                }
+            }
+            if constexpr (detail::is_less_comparable<Type>::value) {
+                auto less = [](const Type* a, const Type* b) { return *a < *b; };
+                std::sort(index.begin(), index.end(), less);
+                auto matches = [&index, &less](const Type& value) {
+                    auto it = std::lower_bound(index.begin(), index.end(), &value, less);
+                    return it != index.end() && !(value < **it);
+                };
+                fn(matches);
+            } else {
+                static_assert(detail::is_hashable<Type>::value, "remove_many and find_many need hashable or ordered elements");
+            }
+        }
+
+        // Consecutive wins by one input after which set operations start galloping through it.
+        static constexpr size_t set_min_gallop = 7;
+
+        // Returns the last node of the chain starting at first whose value compares less than bound,
+        // given that first does. Probes 1, 2, 4, ... nodes ahead, then binary searches the overshoot,
+        // so a run of length m costs O(log m) comparisons.
+        template<typename Compare>
+        static Node* gallop(Node* first, const Type& bound, Compare& comp) {
+            Node* last = first;
+            size_t step = 1;
+            while (true) {
+                Node* probe = last;
+                size_t distance = 0;
+                while (distance < step && probe->next) {
+                    probe = as_node(probe->next);
+                    ++distance;
+                }
+                if (distance == 0) return last;
+                if (!comp(probe->value, bound)) {
+                    while (distance > 1) {
+                        size_t half = distance / 2;
+                        Node* mid = as_node(Chain::advance(last, half));
+                        if (comp(mid->value, bound)) {
+                            last = mid;
+                            distance -= half;
+                        } else {
+                            distance = half;
+                        }
+                    }
+                    return last;
+                }
+                last = probe;
+                if (distance < step) return last;
+                step <<= 1;
+            }
+        }
+
+        // Merges the sorted chains of this list and other into the tail of out by relinking. Elements only in
+        // this list, only in other, or in both are kept as the flags say; every node not kept is destroyed.
+        template<typename Compare>
+        void set_operation_into(forward_list& other, forward_list& out, Compare& comp,
+                                bool keep_first_only, bool keep_second_only, bool keep_common) {
+            this->invalidate_finger();
+            other.invalidate_finger();
+            out.invalidate_finger();
+            Node* a = as_node(this->head);
+            Node* b = as_node(other.head);
+            this->head = nullptr;
+            other.head = nullptr;
+
+            Link** out_tail = Chain::end_link(&out.head);
+
+            // Appends the chain first..last to out, or destroys it.
+            auto take = [&](Node* first, Node* last, bool keep) {
+                Node* next = as_node(Chain::split_after(last));
+                if (keep) {
+                    *out_tail = first;
+                    out_tail = &last->next;
+                } else {
+                    while (first) {
+                        Node* tmp = first;
+                        first = as_node(first->next);
+                        this->destroy_node(tmp);
+                    }
+                }
+                return next;
+            };
+
+            size_t a_wins = 0, b_wins = 0;
+            while (a && b) {
+                if (comp(a->value, b->value)) {
+                    Node* last = ++a_wins >= set_min_gallop ? gallop(a, b->value, comp) : a;
+                    a = take(a, last, keep_first_only);
+                    b_wins = 0;
+                } else if (comp(b->value, a->value)) {
+                    Node* last = ++b_wins >= set_min_gallop ? gallop(b, a->value, comp) : b;
+                    b = take(b, last, keep_second_only);
+                    a_wins = 0;
+                } else {
+                    a = take(a, a, keep_common);
+                    b = take(b, b, false);
+                    a_wins = b_wins = 0;
+                }
+            }
+            // At most one input is left; its remainder is kept or destroyed as a whole.
+            Node* rest = a ? a : b;
+            if (rest) {
+                take(rest, as_node(Chain::last(rest)), a ? keep_first_only : keep_second_only);
+            }
+        }
+
+        // Tests every node against pred in list order and passes each node with the result to visit.
+        // visit may relink or destroy the node it is given. Block predicates see the values gathered into a local buffer.
+        template<typename Predicate, typename Visit>
+        void evaluate(Predicate& pred, Visit visit) {
+            if constexpr (std::is_invocable_v<Predicate&, std::span<const Type>, fwd_list_block_mask&>) {
+                static_assert(std::is_trivially_copyable_v<Type> && std::is_default_constructible_v<Type>,
+                              "block predicates require trivially copyable, default constructible elements");
+                std::array<Node*, fwd_list_block_size> nodes;
+                std::array<Type, fwd_list_block_size> values;
+                Node* current = as_node(this->head);
+                while (current) {
+                    std::size_t n = 0;
+                    for (; current && n < fwd_list_block_size; current = as_node(current->next), ++n) {
+                        nodes[n] = current;
+                        values[n] = current->value;
+                    }
+                    fwd_list_block_mask mask = 0;
+                    pred(std::span<const Type>(values.data(), n), mask);
+                    for (std::size_t i = 0; i < n; ++i) {
+                        visit(nodes[i], ((mask >> i) & 1) != 0);
+                    }
+                }
+            } else {
+                Node* current = as_node(this->head);
+                while (current) {
+                    Node* next = as_node(current->next);
+                    visit(current, static_cast<bool>(pred(current->value)));
+                    current = next;
+                }
+            }
+        }
     };
 
+    // The hot non-template members, defined out of line like forward_list_base::clear.
+    template<typename Type, typename Allocator>
+    void forward_list<Type, Allocator>::resize(size_t count, const Type& value) {
+        size_t current_size = Chain::count(this->head);
+        ATL_FWD_LIST_PROBE3(resize, this, current_size, count);
+        if (count < current_size) {
+            while (count < current_size) {
+                pop_front();
+                --current_size;
+            }
+        } else if (count > current_size) {
+            while (count > current_size) {
+                push_front(value);
+                ++current_size;
+            }
+        }
+    }
+
+    template<typename Type, typename Allocator>
+    void forward_list<Type, Allocator>::merge(forward_list& other) {
+        if (ATL_FWD_LIST_PROBE_ENABLED(merge)) {
+            ATL_FWD_LIST_PROBE4(merge, this, &other, Chain::count(this->head), Chain::count(other.head));
+        }
+        this->invalidate_finger();
+        other.invalidate_finger();
+        Link** pos = &this->head;
+        while (*pos && other.head) {
+            if (as_node(*pos)->value < as_node(other.head)->value) {
+                pos = &(*pos)->next;
+            } else {
+                Node* temp = as_node(other.head);
+                other.head = other.head->next;
+                temp->next = *pos;
+                *pos = temp;
+            }
+        }
+        if (other.head) {
+            *pos = other.head;
+            other.head = nullptr;
+        }
+    }
+
+    template<typename Type, typename Allocator>
+    void forward_list<Type, Allocator>::remove(const Type& value) {
+        this->invalidate_finger();
+        Link** pos = &this->head;
+        while (*pos) {
+            if (as_node(*pos)->value == value) {
+                Node* temp = as_node(*pos);
+                *pos = (*pos)->next;
+                this->destroy_node(temp);
+            } else {
+                pos = &(*pos)->next;
+            }
+        }
+    }
+
+    template<typename Type, typename Allocator>
+    void forward_list<Type, Allocator>::unique() {
+        this->invalidate_finger();
+        Node* current = as_node(this->head);
+        while (current && current->next) {
+            if (current->value == as_node(current->next)->value) {
+                Node* temp = as_node(current->next);
+                current->next = temp->next;
+                this->destroy_node(temp);
+            } else {
+                current = as_node(current->next);
+            }
+        }
+    }
+
+    template<typename Type, typename Allocator>
+    void forward_list<Type, Allocator>::sort() {
+        sort(std::less<>());
+    }
+
+    template<typename Type, typename Allocator>
+    void forward_list<Type, Allocator>::set_union_into(forward_list& other, forward_list& out) {
+        set_union_into(other, out, std::less<>());
+    }
+
+    template<typename Type, typename Allocator>
+    void forward_list<Type, Allocator>::set_intersection_into(forward_list& other, forward_list& out) {
+        set_intersection_into(other, out, std::less<>());
+    }
+
+    template<typename Type, typename Allocator>
+    void forward_list<Type, Allocator>::set_difference_into(forward_list& other, forward_list& out) {
+        set_difference_into(other, out, std::less<>());
+    }
+
+    template<typename Type, typename Allocator>
+    void forward_list<Type, Allocator>::symmetric_difference_into(forward_list& other, forward_list& out) {
+        symmetric_difference_into(other, out, std::less<>());
+    }
+
+    // Defined for targets linking the atl_forward_list library (forward_list.cpp), which explicitly
+    // instantiates the lists below once; translation units then skip instantiating them again.
+#ifdef ATL_FORWARD_LIST_USE_LIBRARY
+    extern template class forward_list_base<int>;
+    extern template class forward_list<int>;
+    extern template class forward_list_base<std::int64_t>;
+    extern template class forward_list<std::int64_t>;
+    extern template class forward_list_base<double>;
+    extern template class forward_list<double>;
+    extern template class forward_list_base<std::string>;
+    extern template class forward_list<std::string>;
+    extern template class forward_list_base<void*>;
+    extern template class forward_list<void*>;
+#endif
+
 } // namespace atl
 
 #endif // FORWARD_LIST_H
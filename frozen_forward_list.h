@@ -0,0 +1,346 @@
+// Frozen Forward List (atl::frozen_forward_list)
+
+/*
+    The atl::frozen_forward_list class template is the read-only form of an atl::forward_list:
+    atl::freeze copies (or moves) the elements into one contiguous array with no link
+    pointers, and thaw() turns it back into a mutable list. For integral types,
+    atl::frozen_delta_list stores the differences between neighbours as variable-length
+    integers instead, which shrinks slowly varying or sorted data several times over.
+*/
+
+#ifndef FROZEN_FORWARD_LIST_H
+#define FROZEN_FORWARD_LIST_H
+
+#include "forward_list.tpp"
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace atl {
+
+    // Tag selecting the delta-compressed frozen form of a list of integers.
+    struct delta_compressed_t {
+        explicit delta_compressed_t() = default;
+    };
+
+    inline constexpr delta_compressed_t delta_compressed{};
+
+
+    /*
+        Frozen Forward List Class (atl::frozen_forward_list)
+        Iterators are plain pointers, so code written against fwd_list_iterator (*, ->, ++, ==)
+        works unchanged, and scans run over contiguous memory.
+    */
+    template<typename Type>
+    class frozen_forward_list {
+    public:
+        using Iterator = const Type*;
+        using ConstIterator = const Type*;
+
+        // Constructor for an empty frozen list.
+        frozen_forward_list() = default;
+
+        // Constructor taking the elements of the range [first, last), in order.
+        template<std::input_iterator InputIt>
+        frozen_forward_list(InputIt first, InputIt last) : values(first, last) {
+            values.shrink_to_fit();
+        }
+
+        // Returns a constant reference to the first element in the list.
+        const Type& front() const {
+            return values.front();
+        }
+
+        // Returns a constant reference to the element at position pos, in constant time.
+        const Type& operator[](size_t pos) const {
+            return values[pos];
+        }
+
+        // Checks if the list is empty.
+        bool empty() const noexcept {
+            return values.empty();
+        }
+
+        // Returns the number of elements.
+        size_t size() const noexcept {
+            return values.size();
+        }
+
+        // Returns the contiguous array of elements.
+        const Type* data() const noexcept {
+            return values.data();
+        }
+
+        // Returns a mutable list holding copies of the elements, in order.
+        template<typename Allocator = allocator<fwd_list_node<Type>>>
+        forward_list<Type, Allocator> thaw(const Allocator& a = Allocator()) const& {
+            return forward_list<Type, Allocator>(values.begin(), values.end(), a);
+        }
+
+        // Returns a mutable list the elements are moved into, in order.
+        template<typename Allocator = allocator<fwd_list_node<Type>>>
+        forward_list<Type, Allocator> thaw(const Allocator& a = Allocator()) && {
+            forward_list<Type, Allocator> list(std::make_move_iterator(values.begin()), std::make_move_iterator(values.end()), a);
+            values.clear();
+            return list;
+        }
+
+        // Returns an iterator to the beginning of the list.
+        Iterator begin() const noexcept {
+            return values.data();
+        }
+
+        // Returns an iterator to the end of the list.
+        Iterator end() const noexcept {
+            return values.data() + values.size();
+        }
+
+        // Returns a constant iterator to the beginning of the list.
+        ConstIterator cbegin() const noexcept {
+            return begin();
+        }
+
+        // Returns a constant iterator to the end of the list.
+        ConstIterator cend() const noexcept {
+            return end();
+        }
+
+    private:
+        std::vector<Type> values; // Elements in list order.
+    };
+
+
+    /*
+        Delta-Compressed Frozen List Class (atl::frozen_delta_list)
+        Each element after the first is stored as the zigzag-encoded difference from its
+        predecessor in LEB128 form, one to ten bytes. Every block_size-th element is also
+        kept whole with the position of the delta after it, so operator[] decodes at most
+        one block.
+    */
+    template<typename Type>
+    class frozen_delta_list {
+        static_assert(std::is_integral_v<Type>, "atl::frozen_delta_list holds integers");
+
+        using Unsigned = std::make_unsigned_t<Type>;
+
+    public:
+        // Elements between two values kept whole.
+        static constexpr size_t block_size = 128;
+
+        class Iterator;
+        using ConstIterator = Iterator;
+
+        // Constructor for an empty frozen list.
+        frozen_delta_list() = default;
+
+        // Constructor encoding the elements of the range [first, last), in order.
+        template<std::input_iterator InputIt>
+        frozen_delta_list(InputIt first, InputIt last) {
+            Type prev{};
+            for (; first != last; ++first) {
+                Type value = *first;
+                if (count % block_size == 0) {
+                    blocks.push_back(block{value, bytes.size()});
+                } else {
+                    Unsigned delta = static_cast<Unsigned>(static_cast<Unsigned>(value) - static_cast<Unsigned>(prev));
+                    put(zigzag(delta));
+                }
+                prev = value;
+                ++count;
+            }
+            bytes.shrink_to_fit();
+            blocks.shrink_to_fit();
+        }
+
+        // Returns the first element in the list.
+        Type front() const {
+            return blocks.front().first;
+        }
+
+        // Returns the element at position pos, decoding from the start of its block.
+        Type operator[](size_t pos) const {
+            const block& b = blocks[pos / block_size];
+            Type value = b.first;
+            const unsigned char* p = bytes.data() + b.offset;
+            for (size_t i = pos % block_size; i > 0; --i) value = step(p, value);
+            return value;
+        }
+
+        // Checks if the list is empty.
+        bool empty() const noexcept {
+            return count == 0;
+        }
+
+        // Returns the number of elements.
+        size_t size() const noexcept {
+            return count;
+        }
+
+        // Returns the number of bytes used by the encoded elements.
+        size_t encoded_bytes() const noexcept {
+            return bytes.size() + blocks.size() * sizeof(block);
+        }
+
+        // Returns a mutable list holding the decoded elements, in order.
+        template<typename Allocator = allocator<fwd_list_node<Type>>>
+        forward_list<Type, Allocator> thaw(const Allocator& a = Allocator()) const {
+            return forward_list<Type, Allocator>(begin(), end(), a);
+        }
+
+        // Returns an iterator to the beginning of the list.
+        Iterator begin() const noexcept {
+            return Iterator(this, 0);
+        }
+
+        // Returns an iterator to the end of the list.
+        Iterator end() const noexcept {
+            return Iterator(this, count);
+        }
+
+        // Returns a constant iterator to the beginning of the list.
+        ConstIterator cbegin() const noexcept {
+            return begin();
+        }
+
+        // Returns a constant iterator to the end of the list.
+        ConstIterator cend() const noexcept {
+            return end();
+        }
+
+        /*
+            Iterator (atl::frozen_delta_list::Iterator)
+            This class decodes one delta per increment; it yields values, not references.
+        */
+        class Iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using difference_type = std::ptrdiff_t;
+            using value_type = Type;
+            using pointer = const Type*;
+            using reference = Type;
+
+            // Constructor for a singular iterator.
+            Iterator() noexcept = default;
+
+            // Dereference operator returning the current value.
+            reference operator*() const noexcept {
+                return value;
+            }
+
+            // Pre-increment operator to move the iterator to the next value.
+            Iterator& operator++() noexcept {
+                if (++index < list->count) {
+                    if (index % block_size == 0) {
+                        const block& b = list->blocks[index / block_size];
+                        value = b.first;
+                        p = list->bytes.data() + b.offset;
+                    } else {
+                        value = step(p, value);
+                    }
+                }
+                return *this;
+            }
+
+            // Post-increment operator to move the iterator to the next value.
+            Iterator operator++(int) noexcept {
+                Iterator tmp = *this;
+                ++*this;
+                return tmp;
+            }
+
+            // Equality operator to compare two iterators.
+            bool operator==(const Iterator& other) const noexcept {
+                return index == other.index;
+            }
+
+            // Inequality operator to compare two iterators.
+            bool operator!=(const Iterator& other) const noexcept {
+                return index != other.index;
+            }
+
+        private:
+            friend class frozen_delta_list;
+
+            const frozen_delta_list* list{nullptr};
+            const unsigned char* p{nullptr}; // Next delta to decode.
+            size_t index{0};
+            Type value{};
+
+            Iterator(const frozen_delta_list* l, size_t i) noexcept : list(l), index(i) {
+                if (i < l->count) {
+                    value = l->blocks.front().first;
+                    p = l->bytes.data();
+                }
+            }
+        };
+
+    private:
+        struct block {
+            Type first; // Element at the start of the block.
+            size_t offset; // Position in bytes of the delta that follows it.
+        };
+
+        std::vector<unsigned char> bytes; // LEB128 zigzag deltas of every element not at a block start.
+        std::vector<block> blocks;
+        size_t count{0};
+
+        // Maps deltas of small magnitude, negative ones included, to small unsigned values.
+        static Unsigned zigzag(Unsigned delta) noexcept {
+            constexpr unsigned shift = sizeof(Unsigned) * 8 - 1;
+            return static_cast<Unsigned>((delta << 1) ^ (static_cast<Unsigned>(0) - (delta >> shift)));
+        }
+
+        static Unsigned unzigzag(Unsigned z) noexcept {
+            return static_cast<Unsigned>((z >> 1) ^ (static_cast<Unsigned>(0) - (z & 1)));
+        }
+
+        // Appends z in LEB128 form.
+        void put(Unsigned z) {
+            while (z >= 0x80) {
+                bytes.push_back(static_cast<unsigned char>(z | 0x80));
+                z = static_cast<Unsigned>(z >> 7);
+            }
+            bytes.push_back(static_cast<unsigned char>(z));
+        }
+
+        // Decodes the delta at p, advancing p, and applies it to value.
+        static Type step(const unsigned char*& p, Type value) noexcept {
+            std::uint64_t z = 0;
+            unsigned shift = 0;
+            unsigned char byte;
+            do {
+                byte = *p++;
+                z |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+                shift += 7;
+            } while (byte & 0x80);
+            return static_cast<Type>(static_cast<Unsigned>(static_cast<Unsigned>(value) + unzigzag(static_cast<Unsigned>(z))));
+        }
+    };
+
+
+    // Returns a frozen copy of list.
+    template<typename Type, typename Allocator>
+    frozen_forward_list<Type> freeze(const forward_list<Type, Allocator>& list) {
+        return frozen_forward_list<Type>(list.cbegin(), list.cend());
+    }
+
+    // Returns a frozen list the elements of list are moved into, leaving list empty.
+    template<typename Type, typename Allocator>
+    frozen_forward_list<Type> freeze(forward_list<Type, Allocator>&& list) {
+        frozen_forward_list<Type> frozen(std::make_move_iterator(list.begin()), std::make_move_iterator(list.end()));
+        list.clear();
+        return frozen;
+    }
+
+    // Returns a delta-compressed frozen copy of a list of integers.
+    template<typename Type, typename Allocator>
+    frozen_delta_list<Type> freeze(const forward_list<Type, Allocator>& list, delta_compressed_t) {
+        return frozen_delta_list<Type>(list.cbegin(), list.cend());
+    }
+
+} // namespace atl
+
+#endif // FROZEN_FORWARD_LIST_H
@@ -0,0 +1,120 @@
+// Forward Chain Core (atl::detail::fwd_chain)
+
+/*
+    Pointer manipulation shared by every atl::forward_list instantiation. None of it depends
+    on the element type, so it works on atl::detail::fwd_link_base, the base of every node,
+    and is compiled once instead of once per element type.
+*/
+
+#ifndef FWD_CHAIN_H
+#define FWD_CHAIN_H
+
+#include <cstddef>
+
+// Keeps the chain loops out of line so that every forward_list instantiation calls one shared copy.
+#if defined(__GNUC__) || defined(__clang__)
+#define ATL_FWD_CHAIN_OUTLINE __attribute__((noinline))
+#else
+#define ATL_FWD_CHAIN_OUTLINE
+#endif
+
+namespace atl {
+
+namespace detail {
+
+    /*
+        Link (atl::detail::fwd_link_base)
+        This struct holds the link shared by all node types; nodes derive from it and add their value.
+    */
+    struct fwd_link_base {
+
+        fwd_link_base* next{nullptr}; // fwd_link_base next*: Pointer to the next node in the chain.
+    };
+
+
+    /*
+        Chain Operations (atl::detail::fwd_chain)
+        Type-independent operations on null-terminated chains of links.
+    */
+    struct fwd_chain {
+
+        using Link = fwd_link_base;
+
+        // Reverses the chain starting at head and returns the new head.
+        ATL_FWD_CHAIN_OUTLINE static Link* reverse(Link* head) noexcept {
+            Link* prev = nullptr;
+            while (head) {
+                Link* next = head->next;
+                head->next = prev;
+                prev = head;
+                head = next;
+            }
+            return prev;
+        }
+
+        // Returns the number of links in the chain starting at head.
+        ATL_FWD_CHAIN_OUTLINE static std::size_t count(const Link* head) noexcept {
+            std::size_t n = 0;
+            for (; head; head = head->next) ++n;
+            return n;
+        }
+
+        // Returns the link n steps after link, or nullptr if the chain ends first.
+        ATL_FWD_CHAIN_OUTLINE static Link* advance(Link* link, std::size_t n) noexcept {
+            for (; link && n > 0; --n) link = link->next;
+            return link;
+        }
+
+        // Returns the last link of the non-empty chain starting at head.
+        ATL_FWD_CHAIN_OUTLINE static Link* last(Link* head) noexcept {
+            while (head->next) head = head->next;
+            return head;
+        }
+
+        // Returns the null pointer terminating the chain that *link starts, so that a chain can be appended there.
+        ATL_FWD_CHAIN_OUTLINE static Link** end_link(Link** link) noexcept {
+            while (*link) link = &(*link)->next;
+            return link;
+        }
+
+        // Inserts the chain starting at head after pos and returns the last inserted link (pos if head is null).
+        ATL_FWD_CHAIN_OUTLINE static Link* splice_after(Link* pos, Link* head) noexcept {
+            if (!head) return pos;
+            Link* tail = last(head);
+            tail->next = pos->next;
+            pos->next = head;
+            return tail;
+        }
+
+        // Detaches and returns everything after pos, leaving pos as the last link.
+        static Link* split_after(Link* pos) noexcept {
+            Link* rest = pos->next;
+            pos->next = nullptr;
+            return rest;
+        }
+
+        // Links node in front of the chain stored in *link.
+        static void link_front(Link** link, Link* node) noexcept {
+            node->next = *link;
+            *link = node;
+        }
+
+        // Unlinks and returns the link stored in *link, which must not be null.
+        static Link* unlink(Link** link) noexcept {
+            Link* node = *link;
+            *link = node->next;
+            return node;
+        }
+
+        // Appends node to the chain ending at *tail and advances tail to its link.
+        static void append(Link**& tail, Link* node) noexcept {
+            *tail = node;
+            tail = &node->next;
+        }
+    };
+
+} // namespace detail
+
+} // namespace atl
+
+#endif // FWD_CHAIN_H
@@ -0,0 +1,55 @@
+// File I/O Helpers (atl::detail)
+
+/*
+    Positional read and write loops shared by the file-backed lists
+    (atl::spilling_forward_list, atl::durable_forward_list).
+*/
+
+#ifndef FWD_LIST_IO_H
+#define FWD_LIST_IO_H
+
+#include <cerrno>
+#include <cstddef>
+#include <system_error>
+#include <unistd.h>
+
+namespace atl {
+
+namespace detail {
+
+    // Writes all of data to fd at offset, throwing std::system_error labelled what on failure.
+    inline void write_fully(int fd, const void* data, std::size_t bytes, off_t offset, const char* what) {
+        const char* p = static_cast<const char*>(data);
+        while (bytes > 0) {
+            ssize_t n = ::pwrite(fd, p, bytes, offset);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                throw std::system_error(errno, std::generic_category(), what);
+            }
+            p += n;
+            bytes -= static_cast<std::size_t>(n);
+            offset += n;
+        }
+    }
+
+    // Reads exactly bytes from fd at offset, throwing std::system_error labelled what on failure or a short file.
+    inline void read_fully(int fd, void* data, std::size_t bytes, off_t offset, const char* what) {
+        char* p = static_cast<char*>(data);
+        while (bytes > 0) {
+            ssize_t n = ::pread(fd, p, bytes, offset);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                throw std::system_error(errno, std::generic_category(), what);
+            }
+            if (n == 0) throw std::system_error(EIO, std::generic_category(), what);
+            p += n;
+            bytes -= static_cast<std::size_t>(n);
+            offset += n;
+        }
+    }
+
+} // namespace detail
+
+} // namespace atl
+
+#endif // FWD_LIST_IO_H
@@ -0,0 +1,94 @@
+// Forward List Probes (atl_forward_list USDT)
+
+/*
+    Static tracepoints for the atl_forward_list provider. Each probe is a nop in the code plus
+    an entry in the .note.stapsdt section laid out as <sys/sdt.h> lays it out, so bpftrace and
+    perf find them the same way. Every entry names a semaphore of its own, which tracers raise
+    while attached, and ATL_FWD_LIST_PROBE_ENABLED(name) tests it. Only these probes carry
+    semaphores: nothing here changes how <sys/sdt.h> emits other probes in the same
+    translation unit, and the header is not needed.
+
+    Define ATL_FWD_LIST_USDT to compile the probes in (ELF on x86-64 or AArch64, GCC or
+    Clang). Otherwise the probes and their arguments vanish and
+    ATL_FWD_LIST_PROBE_ENABLED is false.
+*/
+
+#ifndef FWD_LIST_PROBES_H
+#define FWD_LIST_PROBES_H
+
+#if defined(ATL_FWD_LIST_USDT) && defined(__ELF__) && (defined(__x86_64__) || defined(__aarch64__)) \
+    && (defined(__GNUC__) || defined(__clang__))
+
+#include <type_traits>
+
+// One semaphore per probe, in the .probes section where tracers look for sdt semaphores.
+#define ATL_FWD_LIST_SEMAPHORE(name) \
+    extern "C" { inline volatile unsigned short atl_forward_list_##name##_semaphore \
+        __attribute__((section(".probes"), used)) = 0; }
+ATL_FWD_LIST_SEMAPHORE(clear)
+ATL_FWD_LIST_SEMAPHORE(create_node)
+ATL_FWD_LIST_SEMAPHORE(destroy_node)
+ATL_FWD_LIST_SEMAPHORE(resize)
+ATL_FWD_LIST_SEMAPHORE(merge)
+ATL_FWD_LIST_SEMAPHORE(splice_after)
+ATL_FWD_LIST_SEMAPHORE(remove_if)
+#undef ATL_FWD_LIST_SEMAPHORE
+
+#define ATL_FWD_LIST_PROBE_ENABLED(name) __builtin_expect(atl_forward_list_##name##_semaphore != 0, 0)
+
+// Argument n is described as "size@operand", the size negative for signed types; %n prints the
+// negated constant, so the constant holds the opposite sign.
+#define ATL_FWD_LIST_SDT_ARGFMT(n) "%n[size" #n "]@%[arg" #n "]"
+#define ATL_FWD_LIST_SDT_ARG(n, x) \
+    [size##n] "n" ((std::is_signed_v<std::decay_t<decltype(x)>> ? 1 : -1) * static_cast<int>(sizeof(x))), \
+    [arg##n] "nor" (x)
+
+// The note holds the probe address, the address of .stapsdt.base (for prelink adjustments) and the
+// semaphore address, then the provider, probe and argument strings.
+#define ATL_FWD_LIST_SDT_PROBE(name, argfmt, ...) \
+    __asm__ __volatile__( \
+        "990: nop\n" \
+        ".pushsection .note.stapsdt,\"\",\"note\"\n" \
+        ".balign 4\n" \
+        ".4byte 992f-991f, 994f-993f, 3\n" \
+        "991: .asciz \"stapsdt\"\n" \
+        "992: .balign 4\n" \
+        "993: .8byte 990b\n" \
+        ".8byte _.stapsdt.base\n" \
+        ".8byte atl_forward_list_" #name "_semaphore\n" \
+        ".asciz \"atl_forward_list\"\n" \
+        ".asciz \"" #name "\"\n" \
+        ".asciz \"" argfmt "\"\n" \
+        "994: .balign 4\n" \
+        ".popsection\n" \
+        ".ifndef _.stapsdt.base\n" \
+        ".pushsection .stapsdt.base,\"aG\",\"progbits\",.stapsdt.base,comdat\n" \
+        ".weak _.stapsdt.base\n" \
+        ".hidden _.stapsdt.base\n" \
+        "_.stapsdt.base: .space 1\n" \
+        ".size _.stapsdt.base, 1\n" \
+        ".popsection\n" \
+        ".endif\n" \
+        :: __VA_ARGS__)
+
+#define ATL_FWD_LIST_PROBE2(name, a, b) \
+    ATL_FWD_LIST_SDT_PROBE(name, ATL_FWD_LIST_SDT_ARGFMT(1) " " ATL_FWD_LIST_SDT_ARGFMT(2), \
+        ATL_FWD_LIST_SDT_ARG(1, a), ATL_FWD_LIST_SDT_ARG(2, b))
+#define ATL_FWD_LIST_PROBE3(name, a, b, c) \
+    ATL_FWD_LIST_SDT_PROBE(name, ATL_FWD_LIST_SDT_ARGFMT(1) " " ATL_FWD_LIST_SDT_ARGFMT(2) " " ATL_FWD_LIST_SDT_ARGFMT(3), \
+        ATL_FWD_LIST_SDT_ARG(1, a), ATL_FWD_LIST_SDT_ARG(2, b), ATL_FWD_LIST_SDT_ARG(3, c))
+#define ATL_FWD_LIST_PROBE4(name, a, b, c, d) \
+    ATL_FWD_LIST_SDT_PROBE(name, ATL_FWD_LIST_SDT_ARGFMT(1) " " ATL_FWD_LIST_SDT_ARGFMT(2) " " ATL_FWD_LIST_SDT_ARGFMT(3) \
+        " " ATL_FWD_LIST_SDT_ARGFMT(4), \
+        ATL_FWD_LIST_SDT_ARG(1, a), ATL_FWD_LIST_SDT_ARG(2, b), ATL_FWD_LIST_SDT_ARG(3, c), ATL_FWD_LIST_SDT_ARG(4, d))
+
+#else
+
+#define ATL_FWD_LIST_PROBE2(name, a, b) ((void)0)
+#define ATL_FWD_LIST_PROBE3(name, a, b, c) ((void)0)
+#define ATL_FWD_LIST_PROBE4(name, a, b, c, d) ((void)0)
+#define ATL_FWD_LIST_PROBE_ENABLED(name) false
+
+#endif
+
+#endif // FWD_LIST_PROBES_H
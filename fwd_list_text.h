@@ -0,0 +1,168 @@
+// Text Parsing and Formatting (atl::parse_into, atl::format_to)
+
+/*
+    Conversions between lists of numbers and text, built on std::from_chars and
+    std::to_chars: no locale, no stream state, no virtual calls per character.
+    atl::parse_into builds the list in order straight from the text, and
+    atl::format_to writes through a fixed block buffer.
+*/
+
+#ifndef FWD_LIST_TEXT_H
+#define FWD_LIST_TEXT_H
+
+#include "forward_list.tpp"
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+namespace atl {
+
+namespace detail {
+
+    // Element types std::from_chars and std::to_chars handle.
+    template<typename T>
+    inline constexpr bool is_text_number_v = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+
+    /*
+        Number Reader (atl::detail::number_reader)
+        This input iterator parses one number per increment from text in which numbers are
+        separated by whitespace or commas, throwing on a malformed or out-of-range number.
+    */
+    template<typename Type>
+    class number_reader {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = Type;
+        using pointer = const Type*;
+        using reference = const Type&;
+
+        // Constructor for the end of any text.
+        number_reader() noexcept = default;
+
+        // Constructor reading the first number of text.
+        explicit number_reader(std::string_view text) : p(text.data()), end(text.data() + text.size()) {
+            read();
+        }
+
+        // Dereference operator returning the current number.
+        reference operator*() const noexcept {
+            return value;
+        }
+
+        // Pre-increment operator parsing the next number.
+        number_reader& operator++() {
+            read();
+            return *this;
+        }
+
+        // Post-increment operator parsing the next number.
+        number_reader operator++(int) {
+            number_reader tmp = *this;
+            read();
+            return tmp;
+        }
+
+        // Equality operator; all readers at the end of their text compare equal.
+        bool operator==(const number_reader& other) const noexcept {
+            return p == other.p;
+        }
+
+        // Inequality operator.
+        bool operator!=(const number_reader& other) const noexcept {
+            return p != other.p;
+        }
+
+    private:
+        const char* p{nullptr}; // Next character to parse, or nullptr at the end.
+        const char* end{nullptr};
+        Type value{};
+
+        static bool separator(char c) noexcept {
+            return c == ' ' || c == ',' || c == '\n' || c == '\t' || c == '\r' || c == '\f' || c == '\v';
+        }
+
+        void read() {
+            while (p != end && separator(*p)) ++p;
+            if (p == end) {
+                p = nullptr;
+                return;
+            }
+            std::from_chars_result r = std::from_chars(p, end, value);
+            if (r.ec == std::errc::result_out_of_range) throw std::out_of_range("atl::parse_into: number out of range");
+            if (r.ec != std::errc() || (r.ptr != end && !separator(*r.ptr))) {
+                throw std::invalid_argument("atl::parse_into: malformed number");
+            }
+            p = r.ptr;
+        }
+    };
+
+} // namespace detail
+
+
+    // Parses the numbers in text, separated by whitespace or commas, and appends them to list in order;
+    // returns the number appended. A malformed or out-of-range number throws std::invalid_argument or
+    // std::out_of_range after the numbers before it have been appended.
+    template<typename Type, typename Allocator>
+    std::size_t parse_into(std::string_view text, forward_list<Type, Allocator>& list) {
+        static_assert(detail::is_text_number_v<Type>, "atl::parse_into parses integers and floating-point numbers");
+        using Reader = detail::number_reader<Type>;
+        if (list.empty()) {
+            list.assign(Reader(text), Reader());
+            return static_cast<std::size_t>(std::distance(list.begin(), list.end()));
+        }
+        auto last = list.begin();
+        for (auto next = last; ++next != list.end();) last = next;
+        forward_list<Type, Allocator> parsed(list.get_allocator());
+        try {
+            parsed.assign(Reader(text), Reader());
+        } catch (...) {
+            list.splice_after(last, parsed);
+            throw;
+        }
+        std::size_t count = static_cast<std::size_t>(std::distance(parsed.begin(), parsed.end()));
+        list.splice_after(last, parsed);
+        return count;
+    }
+
+    // Writes the elements of list to out as text, in order, with sep between them; returns the advanced out.
+    // Numbers are formatted into a 4 KiB block that is copied to out whenever it fills up.
+    template<typename OutputIt, typename Type, typename Allocator>
+    OutputIt format_to(OutputIt out, const forward_list<Type, Allocator>& list, std::string_view sep = " ") {
+        static_assert(detail::is_text_number_v<Type>, "atl::format_to formats integers and floating-point numbers");
+        // Longer than any std::to_chars result: 20 digits and a sign, or a shortest round-trip double.
+        constexpr std::size_t max_number = 64;
+        char block[4096];
+        char* pos = block;
+        char* const limit = block + sizeof(block);
+        bool first = true;
+        for (auto it = list.cbegin(); it != list.cend(); ++it) {
+            if (!first) {
+                if (static_cast<std::size_t>(limit - pos) < sep.size()) {
+                    out = std::copy(block, pos, out);
+                    pos = block;
+                }
+                if (sep.size() > sizeof(block)) {
+                    out = std::copy(sep.begin(), sep.end(), out);
+                } else {
+                    pos = std::copy(sep.begin(), sep.end(), pos);
+                }
+            }
+            first = false;
+            if (static_cast<std::size_t>(limit - pos) < max_number) {
+                out = std::copy(block, pos, out);
+                pos = block;
+            }
+            pos = std::to_chars(pos, limit, *it).ptr;
+        }
+        return std::copy(block, pos, out);
+    }
+
+} // namespace atl
+
+#endif // FWD_LIST_TEXT_H
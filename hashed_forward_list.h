@@ -0,0 +1,312 @@
+// Hashed Forward List (atl::hashed_forward_list)
+
+/*
+    The atl::hashed_forward_list class template is a singly linked list whose nodes
+    cache the hash of their value. Equality checks in remove, unique, merge_unique and
+    deduplicate compare the cached hashes first and only call operator== on a match,
+    which pays off for long strings and composite keys.
+*/
+
+#ifndef HASHED_FORWARD_LIST_H
+#define HASHED_FORWARD_LIST_H
+
+#include "forward_list.tpp"
+#include <memory>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace atl {
+
+    /*
+        Node (atl::fwd_list_hashed_node)
+        This struct defines a node storing a value together with its precomputed hash; the link
+        to the next node lives in detail::fwd_link_base, so the chain operations apply to it.
+    */
+    template<typename Type>
+    struct fwd_list_hashed_node : detail::fwd_link_base {
+
+        Type value; // Type value: Stores the value of the node.
+        std::size_t hash{0}; // std::size_t hash: Cached hash of value.
+    };
+
+
+    /*
+        Hashed Forward List Class (atl::hashed_forward_list)
+        This class mirrors the interface of atl::forward_list; the hash of each value is
+        computed once, when its node is created. As in std::unordered_set, values are only
+        reachable as const, so no caller can change a value behind its cached hash.
+    */
+    template<typename Type, typename Hash = std::hash<Type>,
+             typename Allocator = allocator<fwd_list_hashed_node<Type>>>
+    class hashed_forward_list {
+    public:
+        using Node = fwd_list_hashed_node<Type>;
+        using Link = detail::fwd_link_base;
+        using Chain = detail::fwd_chain;
+        using Iterator = fwd_list_iterator<const Type, const Node>;
+        using ConstIterator = Iterator;
+
+        // Constructor initializing the list with the given hasher and allocator.
+        hashed_forward_list(const Hash& h = Hash(), const Allocator& a = Allocator())
+            : head(nullptr), hasher(h), alloc(a), value_alloc(a) {}
+
+        // Destructor that clears the list.
+        ~hashed_forward_list() {
+            clear();
+        }
+
+        // Copy constructor, preserving the order of elements.
+        hashed_forward_list(const hashed_forward_list& other)
+            : head(nullptr), hasher(other.hasher), alloc(other.alloc), value_alloc(other.value_alloc) {
+            Link** tail = &head;
+            for (const Link* current = other.head; current; current = current->next) {
+                Chain::append(tail, create_node(as_node(current)->value, as_node(current)->hash));
+            }
+        }
+
+        // Move constructor.
+        hashed_forward_list(hashed_forward_list&& other) noexcept
+            : head(other.head), hasher(std::move(other.hasher)),
+              alloc(std::move(other.alloc)), value_alloc(std::move(other.value_alloc)) {
+            other.head = nullptr;
+        }
+
+        // Copy assignment operator.
+        hashed_forward_list& operator=(const hashed_forward_list& other) {
+            if (this != &other) {
+                hashed_forward_list tmp(other);
+                swap(tmp);
+            }
+            return *this;
+        }
+
+        // Move assignment operator.
+        hashed_forward_list& operator=(hashed_forward_list&& other) noexcept {
+            if (this != &other) {
+                clear();
+                head = other.head;
+                hasher = std::move(other.hasher);
+                alloc = std::move(other.alloc);
+                value_alloc = std::move(other.value_alloc);
+                other.head = nullptr;
+            }
+            return *this;
+        }
+
+        // Returns the allocator used by the list.
+        Allocator get_allocator() const noexcept {
+            return alloc;
+        }
+
+        // Returns a constant reference to the first element in the list.
+        const Type& front() const {
+            return as_node(head)->value;
+        }
+
+        // Checks if the list is empty.
+        bool empty() const noexcept {
+            return head == nullptr;
+        }
+
+        // Inserts a new element at the front of the list.
+        void push_front(const Type& value) {
+            Chain::link_front(&head, create_node(value, hasher(value)));
+        }
+
+        // Inserts a new element at the front of the list, moving the value.
+        void push_front(Type&& value) {
+            std::size_t h = hasher(value);
+            Chain::link_front(&head, create_node(std::move(value), h));
+        }
+
+        // Constructs and inserts a new element at the front of the list with the given arguments.
+        template<typename... Args>
+        void emplace_front(Args&&... args) {
+            Node* node = alloc.allocate(1);
+            std::allocator_traits<decltype(value_alloc)>::construct(value_alloc, &node->value, std::forward<Args>(args)...);
+            node->hash = hasher(node->value);
+            Chain::link_front(&head, node);
+        }
+
+        // Removes the first element from the list.
+        void pop_front() {
+            if (head) destroy_node(as_node(Chain::unlink(&head)));
+        }
+
+        // Clears the list by destroying all nodes.
+        void clear() {
+            while (head) destroy_node(as_node(Chain::unlink(&head)));
+        }
+
+        // Swaps the contents of this list with other.
+        void swap(hashed_forward_list& other) noexcept {
+            std::swap(head, other.head);
+            std::swap(hasher, other.hasher);
+            std::swap(alloc, other.alloc);
+            std::swap(value_alloc, other.value_alloc);
+        }
+
+        // Removes all elements equal to value; nodes with a different hash are skipped without calling operator==.
+        void remove(const Type& value) {
+            const std::size_t h = hasher(value);
+            Link** pos = &head;
+            while (*pos) {
+                if (as_node(*pos)->hash == h && as_node(*pos)->value == value) {
+                    destroy_node(as_node(Chain::unlink(pos)));
+                } else {
+                    pos = &(*pos)->next;
+                }
+            }
+        }
+
+        // Removes all elements that satisfy the predicate pred.
+        template<typename Predicate>
+        void remove_if(Predicate pred) {
+            Link** pos = &head;
+            while (*pos) {
+                if (pred(as_node(*pos)->value)) {
+                    destroy_node(as_node(Chain::unlink(pos)));
+                } else {
+                    pos = &(*pos)->next;
+                }
+            }
+        }
+
+        // Removes consecutive duplicate elements from the list.
+        void unique() {
+            Link* current = head;
+            while (current && current->next) {
+                if (same(as_node(current), as_node(current->next))) {
+                    destroy_node(as_node(Chain::unlink(&current->next)));
+                } else {
+                    current = current->next;
+                }
+            }
+        }
+
+        // Merges other list into this one, assuming both are sorted.
+        void merge(hashed_forward_list& other) {
+            Link** pos = &head;
+            while (*pos && other.head) {
+                if (as_node(*pos)->value < as_node(other.head)->value) {
+                    pos = &(*pos)->next;
+                } else {
+                    Chain::link_front(pos, Chain::unlink(&other.head));
+                }
+            }
+            if (other.head) {
+                *pos = other.head;
+                other.head = nullptr;
+            }
+        }
+
+        // Merges other list into this one, assuming both are sorted, dropping elements of other equal to one already here.
+        void merge_unique(hashed_forward_list& other) {
+            Link** pos = &head;
+            while (*pos && other.head) {
+                Node* here = as_node(*pos);
+                Node* temp = as_node(other.head);
+                if (here->value < temp->value) {
+                    pos = &here->next;
+                } else if (here->hash == temp->hash && !(temp->value < here->value)) {
+                    destroy_node(as_node(Chain::unlink(&other.head)));
+                } else {
+                    Chain::link_front(pos, Chain::unlink(&other.head));
+                    pos = &temp->next;
+                }
+            }
+            if (other.head) {
+                *pos = other.head;
+                other.head = nullptr;
+            }
+        }
+
+        // Removes every element equal to an earlier one, keeping first occurrences in order.
+        void deduplicate() {
+            std::size_t count = Chain::count(head);
+            if (count < 2) return;
+
+            std::size_t capacity = 1;
+            while (capacity < 2 * count) capacity <<= 1;
+            const std::size_t mask = capacity - 1;
+            std::vector<Node*> table(capacity, nullptr);
+
+            Link** pos = &head;
+            while (*pos) {
+                Node* node = as_node(*pos);
+                std::size_t slot = node->hash & mask;
+                bool duplicate = false;
+                while (table[slot]) {
+                    if (same(table[slot], node)) {
+                        duplicate = true;
+                        break;
+                    }
+                    slot = (slot + 1) & mask;
+                }
+                if (duplicate) {
+                    destroy_node(as_node(Chain::unlink(pos)));
+                } else {
+                    table[slot] = node;
+                    pos = &node->next;
+                }
+            }
+        }
+
+        // Reverses the order of elements in the list.
+        void reverse() {
+            head = Chain::reverse(head);
+        }
+
+        // Returns an iterator to the beginning of the list.
+        Iterator begin() const noexcept {
+            return Iterator(as_node(head));
+        }
+
+        // Returns an iterator to the end of the list.
+        Iterator end() const noexcept {
+            return Iterator(nullptr);
+        }
+
+    private:
+        Link* head; // Pointer to the head node of the list.
+        Hash hasher; // Hash function applied once per value.
+        Allocator alloc; // Allocator used to allocate and deallocate memory for nodes.
+        typename std::allocator_traits<Allocator>::template rebind_alloc<Type> value_alloc; // Rebound allocator for the type Type
+
+        // Checks two nodes for equality, comparing the cached hashes first.
+        static bool same(const Node* a, const Node* b) {
+            return a->hash == b->hash && a->value == b->value;
+        }
+
+        // Returns the node containing link.
+        static Node* as_node(Link* link) noexcept {
+            return static_cast<Node*>(link);
+        }
+
+        // Returns the constant node containing link.
+        static const Node* as_node(const Link* link) noexcept {
+            return static_cast<const Node*>(link);
+        }
+
+        // Creates a new node with the given value and its precomputed hash.
+        template<typename V>
+        Node* create_node(V&& value, std::size_t h) {
+            Node* node = alloc.allocate(1);
+            std::allocator_traits<decltype(value_alloc)>::construct(value_alloc, &node->value, std::forward<V>(value));
+            node->hash = h;
+            node->next = nullptr;
+            return node;
+        }
+
+        // Destroys the given node and deallocates its memory.
+        void destroy_node(Node* node) {
+            std::allocator_traits<decltype(value_alloc)>::destroy(value_alloc, &node->value);
+            alloc.deallocate(node, 1);
+        }
+    };
+
+} // namespace atl
+
+#endif // HASHED_FORWARD_LIST_H
@@ -0,0 +1,842 @@
+// Pool Allocator (atl::pool_allocator)
+
+/*
+    The atl::pool_allocator class template hands out single objects, such as list nodes,
+    from 64 KiB slabs mapped directly from the OS. Slabs whose objects have all been freed
+    are tracked separately and given back to the OS according to a trim policy (a high
+    watermark of empty slabs, a trim interval, or a memory-pressure signal) or on an
+    explicit trim(), so resident memory follows the live object count after a burst.
+    atl::thread_pool_allocator gives each thread a pool of its own instead of one shared,
+    locked pool, and atl::cpu_pool_allocator puts a small cache in front of the shared pool
+    for each CPU.
+*/
+
+#ifndef POOL_ALLOCATOR_H
+#define POOL_ALLOCATOR_H
+
+#include <chrono>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// Per-CPU caches read the current CPU from the rseq area glibc registers for every thread (glibc 2.35 and later).
+#if defined(__linux__) && defined(__GNUC__) && __has_include(<sys/rseq.h>)
+#include <sys/rseq.h>
+#define ATL_POOL_HAS_RSEQ 1
+#else
+#define ATL_POOL_HAS_RSEQ 0
+#endif
+
+namespace atl {
+
+    /*
+        Trim Policy (atl::pool_trim_policy)
+        This struct decides when a pool gives empty slabs back to the OS.
+    */
+    struct pool_trim_policy {
+
+        std::size_t high_watermark{4}; // Empty slabs kept for reuse; any beyond this are released as soon as they empty.
+        std::chrono::milliseconds trim_interval{0}; // When non-zero, a slab emptying this long after the last trim releases all empty slabs.
+        double pressure_threshold{0.0}; // When non-zero, a slab emptying while the memory PSI "some avg10" is at least this releases all
+                                        // empty slabs; the PSI is read at most once a second.
+        bool unmap{true}; // Release slabs with munmap; otherwise keep the mapping and drop its pages with madvise(MADV_DONTNEED).
+    };
+
+namespace detail {
+
+    // Returns the "some avg10" memory pressure (percent of time stalled) read from the PSI file at path, or -1 when unavailable.
+    inline double read_memory_pressure(const char* path) {
+        std::FILE* file = std::fopen(path, "r");
+        if (!file) return -1.0;
+        double avg10 = -1.0;
+        int matched = std::fscanf(file, "some avg10=%lf", &avg10);
+        std::fclose(file);
+        return matched == 1 ? avg10 : -1.0;
+    }
+
+    // Returns the memory pressure of the process's cgroup, found through the "0::<path>" line of /proc/self/cgroup
+    // (cgroup v2), or of the system when that is unavailable, or -1 when neither is.
+    inline double memory_pressure() {
+        char line[4096];
+        char path[4096 + sizeof("/sys/fs/cgroup/memory.pressure")];
+        path[0] = '\0';
+        if (std::FILE* file = std::fopen("/proc/self/cgroup", "r")) {
+            while (std::fgets(line, sizeof(line), file)) {
+                if (std::strncmp(line, "0::", 3) != 0) continue;
+                char* cgroup = line + 3;
+                cgroup[std::strcspn(cgroup, "\n")] = '\0';
+                std::snprintf(path, sizeof(path), "/sys/fs/cgroup%s/memory.pressure", std::strcmp(cgroup, "/") == 0 ? "" : cgroup);
+                break;
+            }
+            std::fclose(file);
+        }
+        double pressure = path[0] ? read_memory_pressure(path) : -1.0;
+        return pressure >= 0.0 ? pressure : read_memory_pressure("/proc/pressure/memory");
+    }
+
+
+    /*
+        Slab Pool (atl::detail::slab_pool)
+        This class manages fixed-size objects in slab_size-aligned slabs, so the slab of an object
+        is found by masking its address. Slabs are kept on three lists by occupancy: partial
+        slabs serve allocations first, empty slabs next, and full slabs are on no list.
+    */
+    class slab_pool {
+    public:
+        static constexpr std::size_t slab_size = 64 * 1024;
+
+        // Constructor for objects of the given size and alignment (at most slab_size / 4).
+        slab_pool(std::size_t object_size, std::size_t object_align)
+            : stride(round_up(object_size < sizeof(void*) ? sizeof(void*) : object_size, object_align)),
+              first_offset(round_up(sizeof(slab), object_align)),
+              capacity((slab_size - first_offset) / stride),
+              last_trim(std::chrono::steady_clock::now()), last_pressure_check() {}
+
+        slab_pool(const slab_pool&) = delete;
+        slab_pool& operator=(const slab_pool&) = delete;
+
+        // Destructor that unmaps every slab; no object may still be in use.
+        ~slab_pool() {
+            release_all(partial);
+            release_all(empty);
+        }
+
+        // Allocates one object.
+        void* allocate() {
+            if (!partial) drain_remote();
+            slab* s = partial;
+            if (!s) {
+                s = empty ? empty : map_slab();
+                if (!s) throw std::bad_alloc();
+                unlink(empty, s);
+                if (!s->decommitted) --empty_count;
+                s->decommitted = false;
+                push(partial, s);
+            }
+            void* p;
+            if (s->free_list) {
+                p = s->free_list;
+                s->free_list = *static_cast<void**>(p);
+            } else {
+                p = reinterpret_cast<char*>(s) + first_offset + s->used * stride;
+                ++s->used;
+            }
+            if (++s->live == capacity) unlink(partial, s);
+            ++live_objects;
+            return p;
+        }
+
+        // Deallocates an object obtained from allocate.
+        void deallocate(void* p) noexcept {
+            slab* s = slab_of(p);
+            *static_cast<void**>(p) = s->free_list;
+            s->free_list = p;
+            --live_objects;
+            if (s->live-- == capacity) {
+                if (s->live == 0) {
+                    make_empty(s);
+                } else {
+                    push(partial, s);
+                }
+            } else if (s->live == 0) {
+                unlink(partial, s);
+                make_empty(s);
+            }
+        }
+
+        // Deallocates an object from a thread other than the one using the pool; lock-free.
+        void deallocate_remote(void* p) noexcept {
+            void* top = remote_free.load(std::memory_order_relaxed);
+            do {
+                *static_cast<void**>(p) = top;
+            } while (!remote_free.compare_exchange_weak(top, p, std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        // Takes every remotely freed object back in one batch; returns the number taken.
+        std::size_t drain_remote() noexcept {
+            if (!remote_free.load(std::memory_order_relaxed)) return 0;
+            void* p = remote_free.exchange(nullptr, std::memory_order_acquire);
+            std::size_t n = 0;
+            while (p) {
+                void* next = *static_cast<void**>(p);
+                deallocate(p);
+                p = next;
+                ++n;
+            }
+            return n;
+        }
+
+        // Releases every empty slab now; returns the number released.
+        std::size_t trim() noexcept {
+            return release_empty(0);
+        }
+
+        // Replaces the trim policy.
+        void set_policy(const pool_trim_policy& p) noexcept {
+            policy = p;
+        }
+
+        // Returns the number of objects currently allocated.
+        std::size_t live() const noexcept {
+            return live_objects;
+        }
+
+        // Returns the number of slabs holding no objects and still committed.
+        std::size_t empty_slabs() const noexcept {
+            return empty_count;
+        }
+
+        // Returns the number of slabs currently mapped.
+        std::size_t mapped_slabs() const noexcept {
+            return mapped_count;
+        }
+
+        // Returns the pool owning the slab that contains p.
+        static slab_pool* owner_of(void* p) noexcept {
+            return slab_of(p)->owner;
+        }
+
+    private:
+        struct slab {
+            slab_pool* owner;
+            slab* prev;
+            slab* next;
+            void* free_list; // Freed objects, linked through their first word.
+            std::size_t used; // Objects handed out from the never-used tail of the slab.
+            std::size_t live; // Objects currently allocated.
+            bool decommitted; // Pages were dropped with madvise; the slab is empty and on the empty list.
+        };
+
+        std::size_t stride;
+        std::size_t first_offset;
+        std::size_t capacity;
+        slab* partial{nullptr}; // Slabs with 0 < live < capacity.
+        slab* empty{nullptr}; // Slabs with live == 0, most recently emptied first.
+        std::size_t empty_count{0}; // Committed slabs on the empty list.
+        std::size_t mapped_count{0};
+        std::size_t live_objects{0};
+        pool_trim_policy policy;
+        std::chrono::steady_clock::time_point last_trim;
+        std::chrono::steady_clock::time_point last_pressure_check; // Last read of the memory PSI, which opens files under the pool lock.
+        alignas(64) std::atomic<void*> remote_free{nullptr}; // Objects freed by other threads, pushed lock-free and drained by the user of the pool.
+
+        static constexpr std::size_t round_up(std::size_t n, std::size_t align) noexcept {
+            return (n + align - 1) / align * align;
+        }
+
+        static slab* slab_of(void* p) noexcept {
+            return reinterpret_cast<slab*>(reinterpret_cast<std::uintptr_t>(p) & ~(slab_size - 1));
+        }
+
+        static void push(slab*& list, slab* s) noexcept {
+            s->prev = nullptr;
+            s->next = list;
+            if (list) list->prev = s;
+            list = s;
+        }
+
+        static void unlink(slab*& list, slab* s) noexcept {
+            if (s->prev) s->prev->next = s->next; else list = s->next;
+            if (s->next) s->next->prev = s->prev;
+            s->prev = s->next = nullptr;
+        }
+
+        // Maps a new slab aligned to slab_size by over-mapping and trimming the ends.
+        slab* map_slab() {
+            void* raw = ::mmap(nullptr, 2 * slab_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (raw == MAP_FAILED) return nullptr;
+            std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(raw);
+            std::uintptr_t aligned = (begin + slab_size - 1) & ~(slab_size - 1);
+            if (aligned > begin) ::munmap(raw, aligned - begin);
+            if (aligned + slab_size < begin + 2 * slab_size) {
+                ::munmap(reinterpret_cast<void*>(aligned + slab_size), begin + 2 * slab_size - aligned - slab_size);
+            }
+            slab* s = ::new(reinterpret_cast<void*>(aligned)) slab{this, nullptr, nullptr, nullptr, 0, 0, false};
+            push(empty, s);
+            ++empty_count;
+            ++mapped_count;
+            return s;
+        }
+
+        // Moves a slab that just lost its last object to the empty list and applies the trim policy.
+        void make_empty(slab* s) noexcept {
+            push(empty, s);
+            ++empty_count;
+            if (empty_count > policy.high_watermark) {
+                release_empty(policy.high_watermark);
+            } else if (policy.trim_interval.count() > 0 || policy.pressure_threshold > 0.0) {
+                auto now = std::chrono::steady_clock::now();
+                if (policy.trim_interval.count() > 0 && now - last_trim >= policy.trim_interval) {
+                    release_empty(0);
+                } else if (policy.pressure_threshold > 0.0 && now - last_pressure_check >= std::chrono::seconds(1)) {
+                    last_pressure_check = now;
+                    if (memory_pressure() >= policy.pressure_threshold) release_empty(0);
+                }
+            }
+        }
+
+        // Releases committed empty slabs until at most keep remain; returns the number released.
+        std::size_t release_empty(std::size_t keep) noexcept {
+            last_trim = std::chrono::steady_clock::now();
+            std::size_t released = 0;
+            slab* s = empty;
+            while (s && empty_count > keep) {
+                slab* next = s->next;
+                if (!s->decommitted) {
+                    --empty_count;
+                    ++released;
+                    if (policy.unmap) {
+                        unlink(empty, s);
+                        ::munmap(s, slab_size);
+                        --mapped_count;
+                    } else {
+                        // Keep the header page; the rest is re-faulted as zero pages on reuse.
+                        s->free_list = nullptr;
+                        s->used = 0;
+                        s->decommitted = true;
+                        std::size_t page = round_up(sizeof(slab), 4096);
+                        ::madvise(reinterpret_cast<char*>(s) + page, slab_size - page, MADV_DONTNEED);
+                    }
+                }
+                s = next;
+            }
+            return released;
+        }
+
+        void release_all(slab*& list) noexcept {
+            while (list) {
+                slab* s = list;
+                list = s->next;
+                ::munmap(s, slab_size);
+            }
+        }
+    };
+
+
+    /*
+        Pool Bypass (atl::detail::pool_bypass)
+        Serves the requests the pool allocators do not take to a slab pool, from operator new:
+        arrays, and objects too large (or too strictly aligned) for a slab to hold several of.
+    */
+    template<typename Type>
+    struct pool_bypass {
+        // Whether a slab holds at least 16 objects of Type, which is when single objects come from a slab pool.
+        static constexpr bool pooled = sizeof(Type) <= slab_pool::slab_size / 16 &&
+                                       alignof(Type) <= slab_pool::slab_size / 16;
+
+        // Returns whether a request for n objects bypasses the slab pools.
+        static constexpr bool takes(std::size_t n) noexcept {
+            return n != 1 || !pooled;
+        }
+
+        static Type* allocate(std::size_t n) {
+            if (n > std::numeric_limits<std::size_t>::max() / sizeof(Type)) {
+                throw std::bad_array_new_length();
+            }
+            return static_cast<Type*>(::operator new(n * sizeof(Type), std::align_val_t(alignof(Type))));
+        }
+
+        static void deallocate(Type* p, std::size_t n) noexcept {
+            ::operator delete(p, n * sizeof(Type), std::align_val_t(alignof(Type)));
+        }
+    };
+
+
+    // Returns the process-wide pool for objects of the given size and alignment, with its mutex.
+    // Pools are never destroyed, so objects may outlive static destruction.
+    template<std::size_t Size, std::size_t Align>
+    struct shared_slab_pool {
+        static slab_pool& pool() {
+            static slab_pool* instance = new slab_pool(Size, Align);
+            return *instance;
+        }
+
+        static std::mutex& mutex() {
+            static std::mutex* instance = new std::mutex;
+            return *instance;
+        }
+    };
+
+
+    /*
+        Thread Pools (atl::detail::thread_slab_pool)
+        Each thread gets its own pool for objects of the given size and alignment. When a
+        thread exits its pool is trimmed and parked, and the next new thread adopts it along
+        with any objects still alive in it; pools are never destroyed.
+    */
+    template<std::size_t Size, std::size_t Align>
+    struct thread_slab_pool {
+
+        // Returns the pool of the calling thread, or nullptr once the thread is exiting.
+        static slab_pool* local() {
+            thread_local holder h;
+            return exited ? nullptr : h.pool;
+        }
+
+        // Returns the pool used by threads that have already released theirs.
+        static slab_pool& fallback() {
+            return shared_slab_pool<Size, Align>::pool();
+        }
+
+        static std::mutex& fallback_mutex() {
+            return shared_slab_pool<Size, Align>::mutex();
+        }
+
+    private:
+        struct holder {
+            slab_pool* pool;
+
+            holder() {
+                std::lock_guard<std::mutex> lock(parked_mutex());
+                auto& parked = parked_pools();
+                if (parked.empty()) {
+                    pool = new slab_pool(Size, Align);
+                } else {
+                    pool = parked.back();
+                    parked.pop_back();
+                }
+            }
+
+            ~holder() {
+                exited = true;
+                pool->drain_remote();
+                pool->trim();
+                std::lock_guard<std::mutex> lock(parked_mutex());
+                parked_pools().push_back(pool);
+            }
+        };
+
+        static inline thread_local bool exited = false;
+
+        static std::vector<slab_pool*>& parked_pools() {
+            static auto* instance = new std::vector<slab_pool*>;
+            return *instance;
+        }
+
+        static std::mutex& parked_mutex() {
+            static std::mutex* instance = new std::mutex;
+            return *instance;
+        }
+    };
+
+
+    // Returns the CPU the calling thread runs on, read from its rseq area, or -1 when rseq is not registered.
+    inline int current_cpu() noexcept {
+#if ATL_POOL_HAS_RSEQ
+        if (__rseq_size == 0) return -1;
+        const volatile struct rseq* area = reinterpret_cast<const volatile struct rseq*>(
+            static_cast<char*>(__builtin_thread_pointer()) + __rseq_offset);
+        return static_cast<int>(area->cpu_id);
+#else
+        return -1;
+#endif
+    }
+
+
+    /*
+        CPU Caches (atl::detail::cpu_slab_cache)
+        One cache of free objects per CPU sits in front of the shared pool for objects of the
+        given size and alignment. A cache is claimed with a try-lock flag, which only fails when
+        its holder was preempted or migrated mid-operation; the caller then goes to the shared
+        pool instead of waiting. Without rseq every thread gets a cache of its own instead.
+    */
+    template<std::size_t Size, std::size_t Align>
+    struct cpu_slab_cache {
+        static constexpr std::size_t capacity = 64;
+
+        struct alignas(64) cache {
+            std::atomic_flag busy;
+            std::size_t count{0};
+            void* slots[capacity];
+        };
+
+        // Claim on a cache, released when it goes out of scope, so a refill that throws does not keep the cache busy.
+        class claimed {
+        public:
+            explicit claimed(cache* c) noexcept : c(c) {}
+            claimed(const claimed&) = delete;
+            claimed& operator=(const claimed&) = delete;
+
+            ~claimed() {
+                if (c) c->busy.clear(std::memory_order_release);
+            }
+
+            explicit operator bool() const noexcept {
+                return c != nullptr;
+            }
+
+            cache& operator*() const noexcept {
+                return *c;
+            }
+
+            cache* operator->() const noexcept {
+                return c;
+            }
+
+        private:
+            cache* c;
+        };
+
+        // Allocates one object, from the cache of the current CPU when possible.
+        static void* allocate() {
+            if (claimed c = claim()) {
+                if (c->count == 0) refill(*c);
+                if (c->count) return c->slots[--c->count];
+            }
+            std::lock_guard<std::mutex> lock(shared::mutex());
+            return shared::pool().allocate();
+        }
+
+        // Deallocates an object into the cache of the current CPU, spilling half of a full cache to the shared pool.
+        static void deallocate(void* p) {
+            if (claimed c = claim()) {
+                if (c->count == capacity) flush(*c, capacity / 2);
+                c->slots[c->count++] = p;
+                return;
+            }
+            std::lock_guard<std::mutex> lock(shared::mutex());
+            shared::pool().deallocate(p);
+        }
+
+        // Empties every cache that is not in use into the shared pool and gives its empty slabs to the OS.
+        static std::size_t trim() {
+            if (rseq_cpus() > 0) {
+                for (std::size_t i = 0; i < rseq_cpus(); ++i) {
+                    if (claimed c = try_claim(cpu_caches()[i])) flush(*c, c->count);
+                }
+            } else if (claimed c = claim()) {
+                flush(*c, c->count);
+            }
+            std::lock_guard<std::mutex> lock(shared::mutex());
+            return shared::pool().trim();
+        }
+
+    private:
+        using shared = shared_slab_pool<Size, Align>;
+
+        // Holds the cache of a thread when rseq is unavailable and flushes it when the thread exits.
+        struct thread_cache {
+            cache c;
+
+            ~thread_cache() {
+                exited = true;
+                flush(c, c.count);
+            }
+        };
+
+        static inline thread_local bool exited = false;
+
+        // Returns the number of per-CPU caches, or 0 when rseq is unavailable and caches are per thread.
+        static std::size_t rseq_cpus() {
+            static const std::size_t cpus = current_cpu() >= 0 ? static_cast<std::size_t>(::sysconf(_SC_NPROCESSORS_CONF)) : 0;
+            return cpus;
+        }
+
+        static cache* cpu_caches() {
+            static cache* caches = rseq_cpus() > 0 ? new cache[rseq_cpus()] : nullptr;
+            return caches;
+        }
+
+        // Claims the cache of the current CPU (or thread); the claim is empty when the cache is in use.
+        static claimed claim() {
+            if (rseq_cpus() > 0) {
+                int cpu = current_cpu();
+                if (cpu < 0 || static_cast<std::size_t>(cpu) >= rseq_cpus()) return claimed(nullptr);
+                return try_claim(cpu_caches()[cpu]);
+            }
+            if (exited) return claimed(nullptr);
+            thread_local thread_cache tc;
+            return try_claim(tc.c);
+        }
+
+        // Claims c, unless it is in use.
+        static claimed try_claim(cache& c) noexcept {
+            return claimed(c.busy.test_and_set(std::memory_order_acquire) ? nullptr : &c);
+        }
+
+        // Moves half a cache worth of objects from the shared pool into c.
+        static void refill(cache& c) {
+            std::lock_guard<std::mutex> lock(shared::mutex());
+            while (c.count < capacity / 2) c.slots[c.count++] = shared::pool().allocate();
+        }
+
+        // Returns the n most recently cached objects of c to the shared pool.
+        static void flush(cache& c, std::size_t n) {
+            std::lock_guard<std::mutex> lock(shared::mutex());
+            for (; n > 0; --n) shared::pool().deallocate(c.slots[--c.count]);
+        }
+    };
+
+} // namespace detail
+
+
+template <typename Type>
+class pool_allocator {
+public:
+
+    using value_type = Type; // value_type: Type of the elements that the allocator handles.
+
+    using pointer = Type*; // pointer: Pointer to the allocated memory.
+
+    using const_pointer = const Type*; // const_pointer: Pointer to the allocated constant memory.
+
+    using reference = Type&; // reference: Reference to the allocated object.
+
+    using const_reference = const Type&; //const_reference: Reference to the constant allocated object.
+
+    template<typename U>
+    struct rebind {
+        using other = pool_allocator<U>;
+    };
+
+
+    // pool_allocator(): Default constructor.
+    pool_allocator() = default;
+
+    // Template copy constructor for converting between different allocator types.
+    template<typename U>
+    pool_allocator(const pool_allocator<U>&) noexcept {}
+
+    // Allocates memory for n objects of type Type; single objects come from the pool.
+    pointer allocate(std::size_t n) {
+        if (bypass::takes(n)) return bypass::allocate(n);
+        std::lock_guard<std::mutex> lock(shared::mutex());
+        return static_cast<pointer>(shared::pool().allocate());
+    }
+
+    // Deallocates the memory pointed to by p, which must come from allocate(n).
+    void deallocate(pointer p, std::size_t n) {
+        if (bypass::takes(n)) return bypass::deallocate(p, n);
+        std::lock_guard<std::mutex> lock(shared::mutex());
+        shared::pool().deallocate(p);
+    }
+
+    // Constructs an object of type Type in the allocated memory using the provided arguments.
+    template<typename U, typename... Args>
+    void construct(U p, Args&&... args) {
+        ::new(static_cast<void*>(p)) Type(std::forward<Args>(args)...);
+    }
+
+    // Destroys the object pointed to by p.
+    template<typename U>
+    void destroy(pointer p) {
+        p->~Type();
+    }
+
+    // Gives every empty slab of the Type pool back to the OS; returns the number released.
+    static std::size_t trim() {
+        std::lock_guard<std::mutex> lock(shared::mutex());
+        return shared::pool().trim();
+    }
+
+    // Sets when the Type pool gives empty slabs back to the OS.
+    static void set_trim_policy(const pool_trim_policy& policy) {
+        std::lock_guard<std::mutex> lock(shared::mutex());
+        shared::pool().set_policy(policy);
+    }
+
+    // All pool allocators of a type share one pool and compare equal.
+    template<typename U>
+    bool operator==(const pool_allocator<U>&) const noexcept {
+        return true;
+    }
+
+    // Destructor.
+    ~pool_allocator() {}
+
+private:
+    using shared = detail::shared_slab_pool<sizeof(Type), alignof(Type)>;
+    using bypass = detail::pool_bypass<Type>;
+};
+
+
+/*
+    Thread Pool Allocator (atl::thread_pool_allocator)
+    Single objects come from a pool owned by the allocating thread, so the fast path takes
+    no lock. An object freed on another thread is pushed onto the owning pool's lock-free
+    remote-free queue, found through the slab header, and the owner takes the whole queue
+    back in one batch when it runs out of free slots. A list filled on one thread can
+    therefore be cleared on another without contention.
+*/
+template <typename Type>
+class thread_pool_allocator {
+public:
+
+    using value_type = Type; // value_type: Type of the elements that the allocator handles.
+
+    using pointer = Type*; // pointer: Pointer to the allocated memory.
+
+    using const_pointer = const Type*; // const_pointer: Pointer to the allocated constant memory.
+
+    using reference = Type&; // reference: Reference to the allocated object.
+
+    using const_reference = const Type&; //const_reference: Reference to the constant allocated object.
+
+    template<typename U>
+    struct rebind {
+        using other = thread_pool_allocator<U>;
+    };
+
+
+    // thread_pool_allocator(): Default constructor.
+    thread_pool_allocator() = default;
+
+    // Template copy constructor for converting between different allocator types.
+    template<typename U>
+    thread_pool_allocator(const thread_pool_allocator<U>&) noexcept {}
+
+    // Allocates memory for n objects of type Type; single objects come from the calling thread's pool.
+    pointer allocate(std::size_t n) {
+        if (bypass::takes(n)) return bypass::allocate(n);
+        if (detail::slab_pool* pool = pools::local()) {
+            return static_cast<pointer>(pool->allocate());
+        }
+        std::lock_guard<std::mutex> lock(pools::fallback_mutex());
+        return static_cast<pointer>(pools::fallback().allocate());
+    }
+
+    // Deallocates the memory pointed to by p, which must come from allocate(n), on any thread.
+    void deallocate(pointer p, std::size_t n) {
+        if (bypass::takes(n)) return bypass::deallocate(p, n);
+        detail::slab_pool* owner = detail::slab_pool::owner_of(p);
+        if (owner == pools::local()) {
+            owner->deallocate(p);
+        } else {
+            owner->deallocate_remote(p);
+        }
+    }
+
+    // Constructs an object of type Type in the allocated memory using the provided arguments.
+    template<typename U, typename... Args>
+    void construct(U p, Args&&... args) {
+        ::new(static_cast<void*>(p)) Type(std::forward<Args>(args)...);
+    }
+
+    // Destroys the object pointed to by p.
+    template<typename U>
+    void destroy(pointer p) {
+        p->~Type();
+    }
+
+    // Takes back objects other threads freed into the calling thread's pool and gives its empty slabs to the OS.
+    static std::size_t trim() {
+        detail::slab_pool* pool = pools::local();
+        if (!pool) return 0;
+        pool->drain_remote();
+        return pool->trim();
+    }
+
+    // Sets when the calling thread's pool gives empty slabs back to the OS.
+    static void set_trim_policy(const pool_trim_policy& policy) {
+        if (detail::slab_pool* pool = pools::local()) pool->set_policy(policy);
+    }
+
+    // All thread pool allocators of a type compare equal; memory may be freed through any of them on any thread.
+    template<typename U>
+    bool operator==(const thread_pool_allocator<U>&) const noexcept {
+        return true;
+    }
+
+    // Destructor.
+    ~thread_pool_allocator() {}
+
+private:
+    using pools = detail::thread_slab_pool<sizeof(Type), alignof(Type)>;
+    using bypass = detail::pool_bypass<Type>;
+};
+
+
+/*
+    CPU Pool Allocator (atl::cpu_pool_allocator)
+    Single objects go through a cache of the CPU the thread runs on, so the memory parked in
+    caches grows with the number of CPUs rather than threads. Caches are refilled from and
+    spilled to the shared pool of atl::pool_allocator in batches of half a cache.
+*/
+template <typename Type>
+class cpu_pool_allocator {
+public:
+
+    using value_type = Type; // value_type: Type of the elements that the allocator handles.
+
+    using pointer = Type*; // pointer: Pointer to the allocated memory.
+
+    using const_pointer = const Type*; // const_pointer: Pointer to the allocated constant memory.
+
+    using reference = Type&; // reference: Reference to the allocated object.
+
+    using const_reference = const Type&; //const_reference: Reference to the constant allocated object.
+
+    template<typename U>
+    struct rebind {
+        using other = cpu_pool_allocator<U>;
+    };
+
+
+    // cpu_pool_allocator(): Default constructor.
+    cpu_pool_allocator() = default;
+
+    // Template copy constructor for converting between different allocator types.
+    template<typename U>
+    cpu_pool_allocator(const cpu_pool_allocator<U>&) noexcept {}
+
+    // Allocates memory for n objects of type Type; single objects come from the current CPU's cache.
+    pointer allocate(std::size_t n) {
+        if (bypass::takes(n)) return bypass::allocate(n);
+        return static_cast<pointer>(caches::allocate());
+    }
+
+    // Deallocates the memory pointed to by p, which must come from allocate(n), on any thread.
+    void deallocate(pointer p, std::size_t n) {
+        if (bypass::takes(n)) return bypass::deallocate(p, n);
+        caches::deallocate(p);
+    }
+
+    // Constructs an object of type Type in the allocated memory using the provided arguments.
+    template<typename U, typename... Args>
+    void construct(U p, Args&&... args) {
+        ::new(static_cast<void*>(p)) Type(std::forward<Args>(args)...);
+    }
+
+    // Destroys the object pointed to by p.
+    template<typename U>
+    void destroy(pointer p) {
+        p->~Type();
+    }
+
+    // Empties the CPU caches into the shared pool and gives its empty slabs back to the OS.
+    static std::size_t trim() {
+        return caches::trim();
+    }
+
+    // Returns whether caches are per CPU (rseq is registered) rather than per thread.
+    static bool per_cpu() noexcept {
+        return detail::current_cpu() >= 0;
+    }
+
+    // All CPU pool allocators of a type compare equal; memory may be freed through any of them on any thread.
+    template<typename U>
+    bool operator==(const cpu_pool_allocator<U>&) const noexcept {
+        return true;
+    }
+
+    // Destructor.
+    ~cpu_pool_allocator() {}
+
+private:
+    using caches = detail::cpu_slab_cache<sizeof(Type), alignof(Type)>;
+    using bypass = detail::pool_bypass<Type>;
+};
+
+
+} // namespace atl
+
+#endif // POOL_ALLOCATOR_H
@@ -0,0 +1,338 @@
+// Spilling Forward List (atl::spilling_forward_list)
+
+/*
+    The atl::spilling_forward_list class template is a singly linked list of trivially
+    copyable values with a memory budget. push_front always goes to an in-memory
+    atl::forward_list; once that exceeds the budget, its cold tail is written to an
+    unlinked temporary file as a segment of raw values and freed. Iteration reads the
+    segments back in chunks, asking the kernel to read ahead of it, so a sequential scan
+    streams from disk while the front of the list stays in memory.
+*/
+
+#ifndef SPILLING_FORWARD_LIST_H
+#define SPILLING_FORWARD_LIST_H
+
+#include "forward_list.tpp"
+#include "fwd_list_io.h"
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace atl {
+
+    /*
+        Spilling Forward List Class (atl::spilling_forward_list)
+        The list is the in-memory part followed by the spilled segments, newest first, since
+        each spill takes the tail of the in-memory part, which precedes every older segment.
+    */
+    template<typename Type, typename Allocator = allocator<fwd_list_node<Type>>>
+    class spilling_forward_list {
+        static_assert(std::is_trivially_copyable_v<Type>, "atl::spilling_forward_list stores values as raw bytes");
+
+    public:
+        using Hot = forward_list<Type, Allocator>;
+        using Node = fwd_list_node<Type>;
+
+        // Values read from disk at once during iteration; the next chunk is read ahead by the kernel.
+        static constexpr std::size_t chunk_size = (64 * 1024) / sizeof(Type) ? (64 * 1024) / sizeof(Type) : 1;
+
+        class Iterator;
+        using ConstIterator = Iterator;
+
+        // Constructor keeping about budget bytes of nodes in memory and spilling to a temporary file in directory
+        // (TMPDIR, or /tmp, when empty).
+        explicit spilling_forward_list(std::size_t budget, std::string directory = std::string(), const Allocator& a = Allocator())
+            : hot(a), budget_nodes(budget / sizeof(Node) > 1 ? budget / sizeof(Node) : 2), dir(std::move(directory)) {}
+
+        // Destructor that closes the spill file.
+        ~spilling_forward_list() {
+            if (fd >= 0) ::close(fd);
+        }
+
+        spilling_forward_list(const spilling_forward_list&) = delete;
+        spilling_forward_list& operator=(const spilling_forward_list&) = delete;
+
+        // Move constructor.
+        spilling_forward_list(spilling_forward_list&& other) noexcept
+            : hot(std::move(other.hot)), hot_count(other.hot_count), budget_nodes(other.budget_nodes),
+              dir(std::move(other.dir)), fd(other.fd), file_end(other.file_end), segments(std::move(other.segments)) {
+            other.hot_count = 0;
+            other.fd = -1;
+            other.file_end = 0;
+            other.segments.clear();
+        }
+
+        // Returns the first element; when it lives on disk it is read into a cached copy.
+        const Type& front() const {
+            if (hot_count > 0) return hot.front();
+            const segment& s = segments.back();
+            detail::read_fully(fd, &front_copy, sizeof(Type), s.offset, "atl::spilling_forward_list: read");
+            return front_copy;
+        }
+
+        // Checks if the list is empty.
+        bool empty() const noexcept {
+            return hot_count == 0 && segments.empty();
+        }
+
+        // Returns the number of elements.
+        std::size_t size() const noexcept {
+            return hot_count + spilled_size();
+        }
+
+        // Returns the number of elements held on disk.
+        std::size_t spilled_size() const noexcept {
+            std::size_t n = 0;
+            for (const segment& s : segments) n += s.count;
+            return n;
+        }
+
+        // Returns the number of elements held in memory.
+        std::size_t resident_size() const noexcept {
+            return hot_count;
+        }
+
+        // Inserts a new element at the front of the list, spilling the cold tail once the budget is exceeded.
+        void push_front(const Type& value) {
+            hot.push_front(value);
+            if (++hot_count > budget_nodes) spill();
+        }
+
+        // Removes the first element from the list. Draining a segment gives its disk space back.
+        void pop_front() {
+            if (hot_count > 0) {
+                hot.pop_front();
+                --hot_count;
+            } else if (!segments.empty()) {
+                segment& s = segments.back();
+                s.offset += sizeof(Type);
+                if (--s.count == 0) {
+                    segments.pop_back();
+                    truncate_file();
+                }
+            }
+        }
+
+        // Clears the list and truncates the spill file.
+        void clear() {
+            hot.clear();
+            hot_count = 0;
+            segments.clear();
+            truncate_file();
+        }
+
+        // Writes everything past the first keep in-memory elements to disk now; returns the number written.
+        std::size_t spill(std::size_t keep) {
+            if (hot_count <= keep) return 0;
+            auto pos = hot.begin();
+            for (std::size_t i = 1; i < keep; ++i) ++pos;
+            std::size_t n = hot_count - keep;
+            open_file();
+            std::vector<Type> buffer;
+            buffer.reserve(n < chunk_size ? n : chunk_size);
+            segment s{file_end, n};
+            off_t offset = file_end;
+            auto it = hot.begin();
+            if (keep) {
+                it = pos;
+                ++it;
+            }
+            for (; it != hot.end(); ++it) {
+                buffer.push_back(*it);
+                if (buffer.size() == chunk_size) {
+                    detail::write_fully(fd, buffer.data(), buffer.size() * sizeof(Type), offset, "atl::spilling_forward_list: write");
+                    offset += static_cast<off_t>(buffer.size() * sizeof(Type));
+                    buffer.clear();
+                }
+            }
+            detail::write_fully(fd, buffer.data(), buffer.size() * sizeof(Type), offset, "atl::spilling_forward_list: write");
+            file_end = offset + static_cast<off_t>(buffer.size() * sizeof(Type));
+            segments.push_back(s);
+            // The pages were just written and will not be read before the scan reaches them.
+            ::posix_fadvise(fd, s.offset, file_end - s.offset, POSIX_FADV_DONTNEED);
+            if (keep) {
+                hot.erase_after(pos, hot.end());
+            } else {
+                hot.clear();
+            }
+            hot_count = keep;
+            return n;
+        }
+
+        // Returns an iterator to the beginning of the list.
+        Iterator begin() const {
+            return Iterator(this);
+        }
+
+        // Returns an iterator to the end of the list.
+        Iterator end() const noexcept {
+            return Iterator();
+        }
+
+        // Returns a constant iterator to the beginning of the list.
+        ConstIterator cbegin() const {
+            return begin();
+        }
+
+        // Returns a constant iterator to the end of the list.
+        ConstIterator cend() const noexcept {
+            return end();
+        }
+
+        /*
+            Iterator (atl::spilling_forward_list::Iterator)
+            This class walks the in-memory nodes, then reads each spilled segment a chunk at a
+            time into a buffer shared by its copies, so it is an input iterator.
+        */
+        class Iterator {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using difference_type = std::ptrdiff_t;
+            using value_type = Type;
+            using pointer = const Type*;
+            using reference = const Type&;
+
+            // Constructor for the end iterator.
+            Iterator() noexcept = default;
+
+            // Dereference operator to access the current value.
+            reference operator*() const {
+                return node ? node->value : (*buffer)[buffer_pos];
+            }
+
+            // Member access operator to access the current value.
+            pointer operator->() const {
+                return &**this;
+            }
+
+            // Pre-increment operator to move the iterator to the next value.
+            Iterator& operator++() {
+                if (node) {
+                    node = static_cast<const Node*>(node->next);
+                    if (!node) enter(list->segments.size());
+                } else if (++index == list->segments[segment - 1].count) {
+                    enter(segment - 1);
+                } else if (++buffer_pos == buffer_len) {
+                    fill();
+                }
+                return *this;
+            }
+
+            // Post-increment operator to move the iterator to the next value.
+            Iterator operator++(int) {
+                Iterator tmp = *this;
+                ++*this;
+                return tmp;
+            }
+
+            // Equality operator to compare two iterators.
+            bool operator==(const Iterator& other) const noexcept {
+                return node == other.node && segment == other.segment && index == other.index;
+            }
+
+            // Inequality operator to compare two iterators.
+            bool operator!=(const Iterator& other) const noexcept {
+                return !(*this == other);
+            }
+
+        private:
+            friend class spilling_forward_list;
+
+            const spilling_forward_list* list{nullptr};
+            const Node* node{nullptr}; // Current in-memory node, or nullptr once on disk.
+            std::size_t segment{0}; // One past the index of the current segment; 0 at the end.
+            std::size_t index{0}; // Position in the current segment.
+            std::shared_ptr<std::vector<Type>> buffer;
+            std::size_t buffer_pos{0};
+            std::size_t buffer_len{0};
+
+            explicit Iterator(const spilling_forward_list* l) : list(l) {
+                node = l->hot_count ? static_cast<const Node*>(l->hot.cbegin().node) : nullptr;
+                if (!node) enter(l->segments.size());
+            }
+
+            // Moves to the start of segment s - 1, or to the end when s is 0.
+            void enter(std::size_t s) {
+                segment = s;
+                index = 0;
+                if (s == 0) {
+                    buffer.reset();
+                    return;
+                }
+                const typename spilling_forward_list::segment& seg = list->segments[s - 1];
+                ::posix_fadvise(list->fd, seg.offset, static_cast<off_t>(seg.count * sizeof(Type)), POSIX_FADV_SEQUENTIAL);
+                if (!buffer || buffer.use_count() > 1) buffer = std::make_shared<std::vector<Type>>(chunk_size);
+                fill();
+            }
+
+            // Reads the chunk starting at index and asks the kernel to start reading the one after it.
+            void fill() {
+                const typename spilling_forward_list::segment& seg = list->segments[segment - 1];
+                std::size_t left = seg.count - index;
+                buffer_len = left < chunk_size ? left : chunk_size;
+                buffer_pos = 0;
+                off_t offset = seg.offset + static_cast<off_t>(index * sizeof(Type));
+                if (buffer.use_count() > 1) buffer = std::make_shared<std::vector<Type>>(chunk_size);
+                detail::read_fully(list->fd, buffer->data(), buffer_len * sizeof(Type), offset, "atl::spilling_forward_list: read");
+                if (left > buffer_len) {
+                    std::size_t next = left - buffer_len < chunk_size ? left - buffer_len : chunk_size;
+                    ::posix_fadvise(list->fd, offset + static_cast<off_t>(buffer_len * sizeof(Type)),
+                                    static_cast<off_t>(next * sizeof(Type)), POSIX_FADV_WILLNEED);
+                }
+            }
+        };
+
+    private:
+        struct segment {
+            off_t offset; // Position of the first value in the spill file.
+            std::size_t count; // Number of values.
+        };
+
+        Hot hot; // In-memory front of the list.
+        std::size_t hot_count{0}; // Number of elements in hot.
+        std::size_t budget_nodes; // Elements hot may hold before its tail is spilled.
+        std::string dir; // Directory of the spill file.
+        int fd{-1}; // Unlinked spill file, opened on the first spill.
+        off_t file_end{0}; // End of the data written to the spill file.
+        std::vector<segment> segments; // Spilled segments, oldest first; the list ends with the oldest.
+        mutable Type front_copy{}; // Copy of the first element when it was read from disk.
+
+        // Spills all but half the budget, so that the next spill is budget / 2 insertions away.
+        void spill() {
+            spill(budget_nodes / 2);
+        }
+
+        // Cuts the spill file after the newest remaining segment, which was written last; the next spill reuses the space.
+        void truncate_file() {
+            file_end = segments.empty() ? 0 : segments.back().offset + static_cast<off_t>(segments.back().count * sizeof(Type));
+            if (fd >= 0 && ::ftruncate(fd, file_end) != 0) {
+                throw std::system_error(errno, std::generic_category(), "atl::spilling_forward_list: truncate");
+            }
+        }
+
+        // Creates the spill file and unlinks it right away, so that it disappears with the list.
+        void open_file() {
+            if (fd >= 0) return;
+            std::string path = dir;
+            if (path.empty()) {
+                const char* tmp = std::getenv("TMPDIR");
+                path = tmp && *tmp ? tmp : "/tmp";
+            }
+            path += "/atl-spill-XXXXXX";
+            fd = ::mkstemp(path.data());
+            if (fd < 0) throw std::system_error(errno, std::generic_category(), "atl::spilling_forward_list: mkstemp");
+            ::unlink(path.c_str());
+        }
+    };
+
+} // namespace atl
+
+#endif // SPILLING_FORWARD_LIST_H
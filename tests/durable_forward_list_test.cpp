@@ -0,0 +1,174 @@
+// Durable Forward List Test (atl::durable_forward_list)
+
+/*
+    Crashes child processes with _exit at chosen points and checks what reopening the list
+    recovers: mutations synced by the flusher without a commit(), committed mutations,
+    snapshots followed by log records, and logs ending in a torn or corrupt record.
+*/
+
+#undef NDEBUG // The checks are asserts, so keep them in release builds.
+
+#include "../durable_forward_list.h"
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+    using durable_list = atl::durable_forward_list<long>;
+
+    // Runs body in a child process that exits without unwinding, as if it crashed right after body.
+    // Lists in body are opened with open_leaked, so no destructor commits on their behalf.
+    template<typename Body>
+    void crash_after(Body body) {
+        pid_t pid = ::fork();
+        assert(pid >= 0);
+        if (pid == 0) {
+            body();
+            ::_exit(0);
+        }
+        int status = 0;
+        ::waitpid(pid, &status, 0);
+        assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    }
+
+    // Opens the list stored at path and never destroys it.
+    durable_list& open_leaked(const std::string& path, const atl::durability_options& options = atl::durability_options()) {
+        return *new durable_list(path, options);
+    }
+
+    // Returns the elements of the list stored at path, in order.
+    std::vector<long> reopen(const std::string& path, const atl::durability_options& options = atl::durability_options()) {
+        durable_list list(path, options);
+        return std::vector<long>(list.begin(), list.end());
+    }
+
+    off_t file_size(const std::string& path) {
+        struct stat st;
+        assert(::stat(path.c_str(), &st) == 0);
+        return st.st_size;
+    }
+
+    // Appends raw bytes to the end of the file at path.
+    void append_bytes(const std::string& path, const std::vector<unsigned char>& bytes) {
+        int fd = ::open(path.c_str(), O_WRONLY | O_APPEND);
+        assert(fd >= 0);
+        assert(::write(fd, bytes.data(), bytes.size()) == static_cast<ssize_t>(bytes.size()));
+        ::close(fd);
+    }
+
+    void remove_files(const std::string& path) {
+        std::remove((path + ".log").c_str());
+        std::remove((path + ".snap").c_str());
+    }
+
+    // Mutations are synced by the flusher within group_delay even though no further mutation arrives.
+    void check_flusher(const std::string& path) {
+        crash_after([&] {
+            durable_list& list = open_leaked(path);
+            list.push_front(1);
+            list.push_front(2);
+            list.push_front(3);
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        });
+        assert((reopen(path) == std::vector<long>{3, 2, 1}));
+    }
+
+    // Mutations committed before the crash survive it, without waiting for the flusher.
+    void check_commit(const std::string& path) {
+        atl::durability_options options;
+        options.group_delay = std::chrono::seconds(60);
+        crash_after([&] {
+            durable_list& list = open_leaked(path, options);
+            list.pop_front();
+            list.push_front(4);
+            list.commit();
+        });
+        assert((reopen(path, options) == std::vector<long>{4, 2, 1}));
+    }
+
+    // A snapshot followed by log records is restored in full.
+    void check_snapshot(const std::string& path) {
+        atl::durability_options options;
+        options.snapshot_bytes = 256;
+        crash_after([&] {
+            durable_list& list = open_leaked(path, options);
+            for (long i = 10; i < 40; ++i) list.push_front(i);
+            list.commit();
+            list.remove(20);
+            list.push_front(99);
+            list.commit();
+        });
+        std::vector<long> values = reopen(path, options);
+        assert(values.size() == 30);
+        assert(values[0] == 99 && values[1] == 39 && values.back() == 10);
+        for (long value : values) assert(value != 20);
+    }
+
+    // A torn record at the end of the log is dropped, and new records follow the last complete one.
+    void check_torn_tail(const std::string& path) {
+        std::vector<long> before = reopen(path);
+        off_t log_size = file_size(path + ".log");
+        // A record header announcing 9 bytes, followed by only part of them.
+        append_bytes(path + ".log", {9, 0, 0, 0, 1, 0x2a, 0, 0});
+        assert(reopen(path) == before);
+        assert(file_size(path + ".log") == log_size);
+
+        crash_after([&] {
+            durable_list& list = open_leaked(path);
+            list.push_front(7);
+            list.commit();
+        });
+        std::vector<long> after = reopen(path);
+        assert(after.size() == before.size() + 1 && after.front() == 7);
+    }
+
+    // A record whose checksum does not match ends the replay.
+    void check_corrupt_tail(const std::string& path) {
+        std::vector<long> before = reopen(path);
+        crash_after([&] {
+            durable_list& list = open_leaked(path);
+            list.push_front(8);
+            list.commit();
+        });
+        // Flip a byte of the value in the last record, which is [size][op][value][checksum].
+        int fd = ::open((path + ".log").c_str(), O_RDWR);
+        assert(fd >= 0);
+        off_t at = file_size(path + ".log") - 4 - static_cast<off_t>(sizeof(long));
+        unsigned char byte;
+        assert(::pread(fd, &byte, 1, at) == 1);
+        byte ^= 0xff;
+        assert(::pwrite(fd, &byte, 1, at) == 1);
+        ::close(fd);
+        assert(reopen(path) == before);
+    }
+
+} // namespace
+
+int main() {
+    const char* tmp = std::getenv("TMPDIR");
+    std::string dir = std::string(tmp && *tmp ? tmp : "/tmp") + "/atl-durable-XXXXXX";
+    assert(::mkdtemp(dir.data()));
+
+    std::string path = dir + "/list";
+    check_flusher(path);
+    check_commit(path);
+    check_torn_tail(path);
+    check_corrupt_tail(path);
+    remove_files(path);
+
+    path = dir + "/snapshotted";
+    check_snapshot(path);
+    check_torn_tail(path);
+    remove_files(path);
+
+    ::rmdir(dir.c_str());
+}
@@ -0,0 +1,141 @@
+// Pool Allocator Test (atl::thread_pool_allocator, atl::cpu_pool_allocator)
+
+/*
+    Checks the paths of the pool allocators that only run across threads: objects freed on
+    another thread go to the owning pool's remote-free queue and come back on a drain, a
+    pool parked by an exiting thread is adopted by the next thread along with its live
+    objects, and trim gives the emptied slabs back. A producer/consumer stress test then
+    builds lists on some threads and clears them on others, checking every element.
+*/
+
+#undef NDEBUG // The checks are asserts, so keep them in release builds.
+
+#include "../forward_list.tpp"
+#include "../pool_allocator.h"
+#include <cassert>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    using Node = atl::fwd_list_node<long>;
+    using thread_list = atl::forward_list<long, atl::thread_pool_allocator<Node>>;
+    using thread_pools = atl::detail::thread_slab_pool<sizeof(Node), alignof(Node)>;
+
+    constexpr long objects = 20000; // Several slabs' worth of nodes.
+
+    // Fills list with count consecutive values starting at first.
+    template<typename List>
+    void fill(List& list, long first, long count) {
+        for (long i = count - 1; i >= 0; --i) list.push_front(first + i);
+    }
+
+    // Nodes freed on another thread stay live in the owning pool until it drains its remote-free queue.
+    void check_remote_free() {
+        atl::detail::slab_pool* pool = thread_pools::local();
+        std::size_t live_before = pool->live();
+
+        thread_list list;
+        fill(list, 0, objects);
+        assert(pool->live() == live_before + objects);
+
+        std::thread([&list] { list.clear(); }).join();
+        assert(list.empty());
+        assert(pool->live() == live_before + objects);
+
+        std::size_t released = atl::thread_pool_allocator<Node>::trim();
+        assert(pool->live() == live_before);
+        assert(released > 0);
+        assert(pool->empty_slabs() == 0);
+    }
+
+    // A pool parked by an exiting thread is adopted by the next thread, with the nodes still in it.
+    void check_adoption() {
+        thread_list list;
+        atl::detail::slab_pool* parked = nullptr;
+        std::thread([&] {
+            parked = thread_pools::local();
+            fill(list, 0, objects);
+        }).join();
+
+        // The pool is parked; these frees land on its remote-free queue.
+        std::size_t half = 0;
+        while (half < objects / 2) {
+            list.pop_front();
+            ++half;
+        }
+        std::thread([&] {
+            atl::detail::slab_pool* adopted = thread_pools::local();
+            assert(adopted == parked);
+            assert(adopted->live() == static_cast<std::size_t>(objects));
+            atl::thread_pool_allocator<Node>::trim();
+            assert(adopted->live() == static_cast<std::size_t>(objects) - half);
+
+            // Nodes allocated by the thread that first owned the pool are freed locally now.
+            long expected = static_cast<long>(half);
+            for (long value : list) assert(value == expected++);
+            list.clear();
+            assert(adopted->live() == 0);
+        }).join();
+    }
+
+    // Producers build lists and hand them to consumers, which check and clear them, so nearly every free is remote.
+    template<typename List>
+    void check_producer_consumer(int producers, int consumers, int lists_per_producer) {
+        std::mutex mutex;
+        std::condition_variable ready;
+        std::deque<List> queue;
+        int finished = 0;
+
+        auto produce = [&](long id) {
+            for (int i = 0; i < lists_per_producer; ++i) {
+                List list;
+                fill(list, id << 32 | static_cast<long>(i) << 16, 1 + (i * 7919 + id * 104729) % 3000);
+                std::lock_guard<std::mutex> lock(mutex);
+                queue.push_back(std::move(list));
+                ready.notify_one();
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            ++finished;
+            ready.notify_all();
+        };
+        auto consume = [&] {
+            while (true) {
+                List list;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    ready.wait(lock, [&] { return !queue.empty() || finished == producers; });
+                    if (queue.empty()) return;
+                    list = std::move(queue.front());
+                    queue.pop_front();
+                }
+                long expected = list.front();
+                assert((expected & 0xffff) == 0);
+                for (long value : list) assert(value == expected++);
+                list.clear();
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (int p = 0; p < producers; ++p) threads.emplace_back(produce, static_cast<long>(p + 1));
+        for (int c = 0; c < consumers; ++c) threads.emplace_back(consume);
+        for (std::thread& t : threads) t.join();
+        assert(queue.empty());
+    }
+
+} // namespace
+
+int main() {
+    check_remote_free();
+    check_adoption();
+
+    check_producer_consumer<thread_list>(3, 2, 200);
+    check_producer_consumer<atl::forward_list<long, atl::cpu_pool_allocator<Node>>>(3, 2, 200);
+
+    // Every thread has exited, flushing its cache (or the CPU caches are flushed here), so the shared pool holds no nodes.
+    atl::cpu_pool_allocator<Node>::trim();
+    assert((atl::detail::shared_slab_pool<sizeof(Node), alignof(Node)>::pool().live() == 0));
+}
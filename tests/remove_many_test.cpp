@@ -0,0 +1,70 @@
+// Remove Many Test (atl::forward_list::remove_many, atl::forward_list::find_many)
+
+/*
+    Checks remove_many and find_many against both key indexes (sorted array and hash set),
+    with keys of the element type and with keys that must be converted to it first.
+*/
+
+#undef NDEBUG // The checks are asserts, so keep them in release builds.
+
+#include "../forward_list.tpp"
+#include <cassert>
+#include <iterator>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace {
+
+    // Checks both operations on a list of long, indexing keys of type Key.
+    template<typename Key>
+    void check_long_keys(int key_count) {
+        atl::forward_list<long> list;
+        for (int i = 999; i >= 0; --i) list.push_front(i % 300);
+        std::vector<Key> keys;
+        for (int i = 0; i < key_count; ++i) keys.push_back(static_cast<Key>(i * 7 % 300));
+        std::set<long> expected(keys.begin(), keys.end());
+
+        std::vector<atl::forward_list<long>::Iterator> found;
+        list.find_many(keys, std::back_inserter(found));
+        std::size_t matching = 0;
+        for (int i = 0; i < 1000; ++i) matching += expected.count(i % 300);
+        assert(found.size() == matching);
+        for (auto it : found) assert(expected.count(*it));
+
+        list.remove_many(keys);
+        std::size_t left = 0;
+        for (long value : list) {
+            assert(!expected.count(value));
+            ++left;
+        }
+        assert(left == 1000 - matching);
+    }
+
+    // Checks string elements matched by C string keys, which are converted before indexing.
+    void check_string_keys(int key_count) {
+        atl::forward_list<std::string> list;
+        for (int i = 0; i < 200; ++i) list.push_front(std::to_string(i));
+        std::vector<std::string> storage;
+        for (int i = 0; i < key_count; ++i) storage.push_back(std::to_string(i * 3));
+        std::vector<const char*> keys;
+        for (const std::string& key : storage) keys.push_back(key.c_str());
+
+        list.remove_many(keys);
+        std::size_t left = 0;
+        for (const std::string& value : list) {
+            assert(std::stoi(value) >= key_count * 3 || std::stoi(value) % 3 != 0);
+            ++left;
+        }
+        assert(left == 200 - static_cast<std::size_t>(key_count < 67 ? key_count : 67));
+    }
+
+} // namespace
+
+int main() {
+    for (int key_count : {5, 200}) {
+        check_long_keys<long>(key_count);
+        check_long_keys<int>(key_count);
+        check_string_keys(key_count);
+    }
+}
@@ -0,0 +1,111 @@
+// Selection Test (atl::forward_list::nth_element, atl::forward_list::partial_sort, atl::forward_list::select_k)
+
+/*
+    Checks nth_element against std::nth_element and partial_sort against std::partial_sort
+    on random lists and lists heavy with duplicates, for every position of small lists and
+    random positions of larger ones, and checks that select_k leaves the k smallest first.
+*/
+
+#undef NDEBUG // The checks are asserts, so keep them in release builds.
+
+#include "../forward_list.tpp"
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <random>
+#include <vector>
+
+namespace {
+
+    // Returns the elements of list in order.
+    std::vector<int> contents(const atl::forward_list<int>& list) {
+        return std::vector<int>(list.cbegin(), list.cend());
+    }
+
+    // Returns values sorted, for comparing the elements of two lists regardless of order.
+    std::vector<int> sorted(std::vector<int> values) {
+        std::sort(values.begin(), values.end());
+        return values;
+    }
+
+    // Checks the element nth_element places at n, and that the elements around it are partitioned by it.
+    template<typename Compare>
+    void check_nth_element(const std::vector<int>& values, std::size_t n, Compare comp) {
+        atl::forward_list<int> list;
+        list.assign(values.begin(), values.end());
+        list.nth_element(n, comp);
+        std::vector<int> result = contents(list);
+        assert(sorted(result) == sorted(values));
+        if (n >= values.size()) return;
+
+        std::vector<int> expected = values;
+        std::nth_element(expected.begin(), expected.begin() + n, expected.end(), comp);
+        assert(result[n] == expected[n]);
+        for (std::size_t i = 0; i < n; ++i) assert(!comp(result[n], result[i]));
+        for (std::size_t i = n + 1; i < result.size(); ++i) assert(!comp(result[i], result[n]));
+    }
+
+    // Checks that partial_sort leaves the same first k elements as std::partial_sort and keeps the rest.
+    template<typename Compare>
+    void check_partial_sort(const std::vector<int>& values, std::size_t k, Compare comp) {
+        atl::forward_list<int> list;
+        list.assign(values.begin(), values.end());
+        list.partial_sort(k, comp);
+        std::vector<int> result = contents(list);
+        assert(sorted(result) == sorted(values));
+
+        std::size_t prefix = std::min(k, values.size());
+        std::vector<int> expected = values;
+        std::partial_sort(expected.begin(), expected.begin() + prefix, expected.end(), comp);
+        assert(std::equal(result.begin(), result.begin() + prefix, expected.begin()));
+    }
+
+    // Checks that select_k leaves the k smallest elements first, in any order.
+    void check_select_k(const std::vector<int>& values, std::size_t k) {
+        atl::forward_list<int> list;
+        list.assign(values.begin(), values.end());
+        list.select_k(k);
+        std::vector<int> result = contents(list);
+        assert(sorted(result) == sorted(values));
+
+        std::size_t prefix = std::min(k, values.size());
+        std::vector<int> expected = sorted(values);
+        assert(sorted(std::vector<int>(result.begin(), result.begin() + prefix)) ==
+               std::vector<int>(expected.begin(), expected.begin() + prefix));
+    }
+
+    // Checks every selection with position (or count) n, ascending and descending.
+    void check_position(const std::vector<int>& values, std::size_t n) {
+        check_nth_element(values, n, std::less<>());
+        check_nth_element(values, n, std::greater<>());
+        check_partial_sort(values, n, std::less<>());
+        check_partial_sort(values, n, std::greater<>());
+        check_select_k(values, n);
+    }
+
+    // Returns n values drawn uniformly from [0, range).
+    std::vector<int> random_values(std::mt19937& rng, std::size_t n, int range) {
+        std::uniform_int_distribution<int> value(0, range - 1);
+        std::vector<int> values(n);
+        for (int& v : values) v = value(rng);
+        return values;
+    }
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(107);
+    for (std::size_t size = 0; size <= 40; ++size) {
+        for (int range : {1, 3, 1 << 20}) {
+            std::vector<int> values = random_values(rng, size, range);
+            for (std::size_t n = 0; n <= size + 1; ++n) check_position(values, n);
+        }
+    }
+    for (int round = 0; round < 200; ++round) {
+        std::size_t size = std::uniform_int_distribution<std::size_t>(1, 3000)(rng);
+        std::vector<int> values = random_values(rng, size, round % 3 ? 1 << 20 : 4);
+        if (round % 5 == 0) std::sort(values.begin(), values.end());
+        if (round % 5 == 1) std::sort(values.rbegin(), values.rend());
+        check_position(values, std::uniform_int_distribution<std::size_t>(0, size - 1)(rng));
+    }
+}
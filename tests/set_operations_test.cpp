@@ -0,0 +1,139 @@
+// Set Operations Test (atl::forward_list::set_union_into and the other set operations)
+
+/*
+    Checks the four set operations against std::set_union, std::set_intersection,
+    std::set_difference and std::set_symmetric_difference on sorted lists with duplicates.
+    The inputs interleave in blocks of random length, so that long blocks make the
+    operations gallop. Elements are tagged with the list they came from, so the check also
+    covers which of two equal elements is kept.
+*/
+
+#undef NDEBUG // The checks are asserts, so keep them in release builds.
+
+#include "../forward_list.tpp"
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+    using tagged = std::pair<int, int>; // Key, then a tag telling the input and position it came from.
+
+    // Orders tagged elements by key only, so that equal keys from the two inputs compare equal.
+    struct key_less {
+        bool operator()(const tagged& a, const tagged& b) const { return a.first < b.first; }
+    };
+
+    enum class operation { set_union, set_intersection, set_difference, symmetric_difference };
+
+    // Returns the elements of list in order.
+    std::vector<tagged> contents(const atl::forward_list<tagged>& list) {
+        return std::vector<tagged>(list.cbegin(), list.cend());
+    }
+
+    // Runs op on lists holding a and b, appending to a list that already holds a marker element,
+    // and checks the result against the standard algorithm.
+    void check(operation op, const std::vector<tagged>& a, const std::vector<tagged>& b) {
+        atl::forward_list<tagged> first, second, out;
+        first.assign(a.begin(), a.end());
+        second.assign(b.begin(), b.end());
+        const tagged marker{-1, -1};
+        out.push_front(marker);
+
+        std::vector<tagged> expected{marker};
+        auto into = std::back_inserter(expected);
+        switch (op) {
+        case operation::set_union:
+            first.set_union_into(second, out, key_less());
+            std::set_union(a.begin(), a.end(), b.begin(), b.end(), into, key_less());
+            break;
+        case operation::set_intersection:
+            first.set_intersection_into(second, out, key_less());
+            std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), into, key_less());
+            break;
+        case operation::set_difference:
+            first.set_difference_into(second, out, key_less());
+            std::set_difference(a.begin(), a.end(), b.begin(), b.end(), into, key_less());
+            break;
+        case operation::symmetric_difference:
+            first.symmetric_difference_into(second, out, key_less());
+            std::set_symmetric_difference(a.begin(), a.end(), b.begin(), b.end(), into, key_less());
+            break;
+        }
+        assert(contents(out) == expected);
+        assert(first.empty());
+        assert(second.empty());
+    }
+
+    // Checks the operator< overloads of op on the keys of a and b against the standard algorithm.
+    void check_default(operation op, const std::vector<tagged>& a, const std::vector<tagged>& b) {
+        std::vector<int> x, y;
+        for (const tagged& t : a) x.push_back(t.first);
+        for (const tagged& t : b) y.push_back(t.first);
+        atl::forward_list<int> first, second, out;
+        first.assign(x.begin(), x.end());
+        second.assign(y.begin(), y.end());
+
+        std::vector<int> expected;
+        auto into = std::back_inserter(expected);
+        switch (op) {
+        case operation::set_union:
+            first.set_union_into(second, out);
+            std::set_union(x.begin(), x.end(), y.begin(), y.end(), into);
+            break;
+        case operation::set_intersection:
+            first.set_intersection_into(second, out);
+            std::set_intersection(x.begin(), x.end(), y.begin(), y.end(), into);
+            break;
+        case operation::set_difference:
+            first.set_difference_into(second, out);
+            std::set_difference(x.begin(), x.end(), y.begin(), y.end(), into);
+            break;
+        case operation::symmetric_difference:
+            first.symmetric_difference_into(second, out);
+            std::set_symmetric_difference(x.begin(), x.end(), y.begin(), y.end(), into);
+            break;
+        }
+        assert(std::vector<int>(out.cbegin(), out.cend()) == expected);
+    }
+
+    // Fills a and b with sorted keys handed out in blocks of up to max_block consecutive keys, each block
+    // going to a, to b, or to both; keys repeat up to max_repeat times within a list.
+    void make_inputs(std::mt19937& rng, int keys, int max_block, int max_repeat,
+                     std::vector<tagged>& a, std::vector<tagged>& b) {
+        std::uniform_int_distribution<int> block(1, max_block);
+        std::uniform_int_distribution<int> owner(0, 2);
+        std::uniform_int_distribution<int> repeat(1, max_repeat);
+        a.clear();
+        b.clear();
+        for (int key = 0; key < keys;) {
+            int who = owner(rng);
+            for (int end = std::min(keys, key + block(rng)); key < end; ++key) {
+                if (who != 1) for (int r = repeat(rng); r > 0; --r) a.emplace_back(key, static_cast<int>(a.size()));
+                if (who != 0) for (int r = repeat(rng); r > 0; --r) b.emplace_back(key, -1 - static_cast<int>(b.size()));
+            }
+        }
+    }
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(108);
+    std::vector<tagged> a, b;
+    for (int round = 0; round < 400; ++round) {
+        int keys = std::uniform_int_distribution<int>(0, round < 200 ? 30 : 3000)(rng);
+        int max_block = round % 4 == 0 ? 1 : round % 4 == 1 ? 4 : round % 4 == 2 ? 40 : 1000;
+        make_inputs(rng, keys, max_block, 1 + round % 3, a, b);
+        for (operation op : {operation::set_union, operation::set_intersection,
+                             operation::set_difference, operation::symmetric_difference}) {
+            check(op, a, b);
+            check(op, b, a);
+            check(op, a, {});
+            check(op, {}, b);
+            check_default(op, a, b);
+        }
+    }
+}
@@ -0,0 +1,115 @@
+// Sort Test (atl::forward_list::sort)
+
+/*
+    Checks sort against std::stable_sort on random lists, lists with heavy duplicates, and
+    lists made of ascending and descending runs, comparing elements tagged with their
+    original position so that stability is checked as well as order.
+*/
+
+#undef NDEBUG // The checks are asserts, so keep them in release builds.
+
+#include "../forward_list.tpp"
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+    using tagged = std::pair<int, int>; // Key, then the position the element started at.
+
+    // Builds a list holding values in order.
+    template<typename Type>
+    atl::forward_list<Type> make_list(const std::vector<Type>& values) {
+        atl::forward_list<Type> list;
+        list.assign(values.begin(), values.end());
+        return list;
+    }
+
+    // Returns the elements of list in order.
+    template<typename Type>
+    std::vector<Type> contents(const atl::forward_list<Type>& list) {
+        return std::vector<Type>(list.cbegin(), list.cend());
+    }
+
+    // Sorts keys, tagged with their positions, by key with comp and checks the result against std::stable_sort.
+    template<typename Compare>
+    void check_stable(const std::vector<int>& keys, Compare comp) {
+        std::vector<tagged> values;
+        for (int i = 0; i < static_cast<int>(keys.size()); ++i) values.emplace_back(keys[i], i);
+        auto by_key = [&comp](const tagged& a, const tagged& b) { return comp(a.first, b.first); };
+
+        atl::forward_list<tagged> list = make_list(values);
+        list.sort(by_key);
+        std::stable_sort(values.begin(), values.end(), by_key);
+        assert(contents(list) == values);
+    }
+
+    // Sorts keys with the default order and checks the result against std::sort.
+    void check_default(const std::vector<int>& keys) {
+        atl::forward_list<int> list = make_list(keys);
+        list.sort();
+        std::vector<int> expected = keys;
+        std::sort(expected.begin(), expected.end());
+        assert(contents(list) == expected);
+    }
+
+    // Returns n keys drawn uniformly from [0, range).
+    std::vector<int> random_keys(std::mt19937& rng, std::size_t n, int range) {
+        std::uniform_int_distribution<int> key(0, range - 1);
+        std::vector<int> keys(n);
+        for (int& k : keys) k = key(rng);
+        return keys;
+    }
+
+    // Returns n keys made of ascending and descending runs of random lengths, with repeated keys inside runs.
+    std::vector<int> run_keys(std::mt19937& rng, std::size_t n, int max_run) {
+        std::uniform_int_distribution<int> length(1, max_run);
+        std::uniform_int_distribution<int> start(0, 1000);
+        std::uniform_int_distribution<int> step(0, 2);
+        std::vector<int> keys;
+        bool ascending = true;
+        while (keys.size() < n) {
+            int k = start(rng);
+            for (int i = length(rng); i > 0 && keys.size() < n; --i) {
+                keys.push_back(k);
+                k += ascending ? step(rng) : -step(rng);
+            }
+            ascending = !ascending;
+        }
+        return keys;
+    }
+
+    // Checks keys sorted ascending, descending and with the default order.
+    void check_keys(const std::vector<int>& keys) {
+        check_stable(keys, std::less<>());
+        check_stable(keys, std::greater<>());
+        check_default(keys);
+    }
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(106);
+    for (std::size_t n : {0, 1, 2, 3, 31, 32, 33, 100, 1000, 5000}) {
+        check_keys(random_keys(rng, n, 1 << 20));
+        check_keys(random_keys(rng, n, 3));
+        check_keys(random_keys(rng, n, 1));
+        check_keys(run_keys(rng, n, 8));
+        check_keys(run_keys(rng, n, 200));
+
+        std::vector<int> ascending(n), descending(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            ascending[i] = static_cast<int>(i / 4);
+            descending[i] = static_cast<int>((n - i) / 4);
+        }
+        check_keys(ascending);
+        check_keys(descending);
+    }
+    for (int round = 0; round < 200; ++round) {
+        std::size_t n = std::uniform_int_distribution<std::size_t>(0, 300)(rng);
+        check_keys(round % 2 ? random_keys(rng, n, 1 + round % 7) : run_keys(rng, n, 1 + round % 50));
+    }
+}
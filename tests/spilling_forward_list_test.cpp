@@ -0,0 +1,139 @@
+// Spilling Forward List Test (atl::spilling_forward_list)
+
+/*
+    Runs random push_front, pop_front, spill and clear operations on spilling lists and on a
+    std::deque model, comparing contents, sizes and the first element as it goes. A record
+    type of 4 KiB puts only 16 values in a read chunk, so scans cross chunk and segment
+    boundaries often; a list of long grows long enough to spill segments longer than a
+    chunk. The spill file is found through /proc/self/fd to check that it is cut back as
+    segments drain.
+*/
+
+#undef NDEBUG // The checks are asserts, so keep them in release builds.
+
+#include "../spilling_forward_list.h"
+#include <cassert>
+#include <cstdlib>
+#include <deque>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <sys/stat.h>
+
+namespace {
+
+    // A value spanning most of a page, so that a read chunk holds only a few.
+    struct record {
+        long value;
+        char padding[4096 - sizeof(long)];
+
+        bool operator==(long v) const { return value == v; }
+    };
+
+    // Returns v as a value of the type pointed to by the (unused) second argument.
+    record make(long v, record*) {
+        record r{};
+        r.value = v;
+        return r;
+    }
+
+    long make(long v, long*) {
+        return v;
+    }
+
+    // Returns the size of the open file whose (unlinked) path starts with dir, or -1 when there is none.
+    long long spill_file_size(const std::string& dir) {
+        for (const auto& entry : std::filesystem::directory_iterator("/proc/self/fd")) {
+            std::error_code error;
+            std::string target = std::filesystem::read_symlink(entry.path(), error).string();
+            if (error || target.compare(0, dir.size(), dir) != 0) continue;
+            struct stat st;
+            if (::stat(entry.path().c_str(), &st) == 0) return st.st_size;
+        }
+        return -1;
+    }
+
+    // Checks that list holds the values of model, in order.
+    template<typename List>
+    void check_contents(const List& list, const std::deque<long>& model) {
+        assert(list.size() == model.size());
+        assert(list.empty() == model.empty());
+        auto expected = model.begin();
+        for (const auto& value : list) {
+            assert(expected != model.end());
+            assert(value == *expected);
+            ++expected;
+        }
+        assert(expected == model.end());
+    }
+
+    // Runs steps random operations on a list of Type keeping about budget bytes in memory, pushing and popping
+    // up to max_burst values at a time.
+    template<typename Type>
+    void run(std::size_t budget, int max_burst, int steps, unsigned seed) {
+        std::string dir = (std::filesystem::temp_directory_path() / "atl-spill-test-XXXXXX").string();
+        assert(::mkdtemp(dir.data()));
+
+        {
+            atl::spilling_forward_list<Type> list(budget, dir);
+            std::deque<long> model;
+            std::mt19937 rng(seed);
+            std::uniform_int_distribution<int> op(0, 99);
+            long next = 0;
+            for (int step = 0; step < steps; ++step) {
+                int o = op(rng);
+                if (o < 55) {
+                    // Bursts of pushes, so that several spills happen between drains.
+                    for (int n = std::uniform_int_distribution<int>(1, max_burst)(rng); n > 0; --n) {
+                        list.push_front(make(next, static_cast<Type*>(nullptr)));
+                        model.push_front(next++);
+                    }
+                } else if (o < 93) {
+                    for (int n = std::uniform_int_distribution<int>(1, max_burst)(rng); n > 0 && !model.empty(); --n) {
+                        assert(list.front() == model.front());
+                        list.pop_front();
+                        model.pop_front();
+                    }
+                } else if (o < 98) {
+                    std::size_t keep = std::uniform_int_distribution<std::size_t>(0, list.resident_size())(rng);
+                    std::size_t resident = list.resident_size();
+                    assert(list.spill(keep) == (resident > keep ? resident - keep : 0));
+                    assert(list.resident_size() == (resident < keep ? resident : keep));
+                } else {
+                    list.clear();
+                    model.clear();
+                }
+
+                assert(list.size() == model.size());
+                assert(list.resident_size() + list.spilled_size() == model.size());
+                if (!model.empty()) assert(list.front() == model.front());
+                long long file_size = spill_file_size(dir);
+                if (file_size >= 0) {
+                    assert(file_size >= static_cast<long long>(list.spilled_size() * sizeof(Type)));
+                    if (list.spilled_size() == 0) assert(file_size == 0);
+                }
+                if (step % 50 == 0) check_contents(list, model);
+            }
+            check_contents(list, model);
+
+            while (!model.empty()) {
+                assert(list.front() == model.front());
+                list.pop_front();
+                model.pop_front();
+            }
+            assert(list.empty());
+            long long file_size = spill_file_size(dir);
+            assert(file_size == -1 || file_size == 0);
+        }
+
+        assert(spill_file_size(dir) == -1);
+        std::filesystem::remove(dir);
+    }
+
+} // namespace
+
+int main() {
+    run<record>(256 * 1024, 64, 2000, 121);
+    run<long>(1024 * 1024, 2048, 1500, 122);
+    run<long>(256, 64, 2000, 123);
+}
@@ -0,0 +1,306 @@
+// Variable-Length Forward List (atl::varlen_forward_list)
+
+/*
+    The atl::varlen_forward_list class template is a singly linked list of byte strings
+    whose payload is stored inline, right after the node header, in the same allocation.
+    A list of N strings therefore costs N allocations instead of 2N.
+*/
+
+#ifndef VARLEN_FORWARD_LIST_H
+#define VARLEN_FORWARD_LIST_H
+
+#include "allocator.h"
+#include "fwd_chain.h"
+#include <memory>
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+namespace atl {
+
+    /*
+        Node (atl::varlen_fwd_list_node)
+        This struct defines the header of a node; size bytes of payload follow it in memory.
+        The link to the next node lives in detail::fwd_link_base, so the chain operations apply to it.
+    */
+    struct varlen_fwd_list_node : detail::fwd_link_base {
+
+        std::size_t size{0}; // std::size_t size: Number of payload bytes stored after the header.
+
+        // Returns a pointer to the payload.
+        char* data() noexcept {
+            return reinterpret_cast<char*>(this + 1);
+        }
+
+        // Returns a constant pointer to the payload.
+        const char* data() const noexcept {
+            return reinterpret_cast<const char*>(this + 1);
+        }
+
+        // Returns the payload as a string view.
+        std::string_view view() const noexcept {
+            return std::string_view(data(), size);
+        }
+
+        // Returns the payload as a span of bytes.
+        std::span<const std::byte> bytes() const noexcept {
+            return std::span<const std::byte>(reinterpret_cast<const std::byte*>(data()), size);
+        }
+
+        // Returns the number of header-sized slots needed to hold a node with n payload bytes;
+        // n must not exceed varlen_forward_list::max_size(), or the count wraps.
+        static constexpr std::size_t slots(std::size_t n) noexcept {
+            return 1 + (n + sizeof(varlen_fwd_list_node) - 1) / sizeof(varlen_fwd_list_node);
+        }
+    };
+
+
+    /*
+        Iterator (atl::varlen_fwd_list_iterator)
+        This struct defines an iterator yielding each payload as a std::string_view.
+    */
+    struct varlen_fwd_list_iterator {
+
+        using iterator = varlen_fwd_list_iterator;
+        using Node = varlen_fwd_list_node;
+
+        using value_type = std::string_view;
+        using reference = std::string_view;
+
+        const Node* node; // const Node node*: Pointer to the current node.
+
+        // Constructor initializing the iterator to point to the node n.
+        varlen_fwd_list_iterator(const Node* n = nullptr) noexcept : node(n) {}
+
+        // Dereference operator returning a view of the current payload.
+        reference operator*() const {
+            return node->view();
+        }
+
+        // Returns the current payload as a span of bytes.
+        std::span<const std::byte> bytes() const {
+            return node->bytes();
+        }
+
+        // Pre-increment operator to move the iterator to the next node.
+        iterator& operator++() {
+            node = static_cast<const Node*>(node->next);
+            return *this;
+        }
+
+        // Post-increment operator to move the iterator to the next node.
+        iterator operator++(int) {
+            iterator tmp = *this;
+            node = static_cast<const Node*>(node->next);
+            return tmp;
+        }
+
+        // Equality operator to compare two iterators.
+        bool operator==(const iterator& other) const {
+            return node == other.node;
+        }
+
+        // Inequality operator to compare two iterators.
+        bool operator!=(const iterator& other) const {
+            return node != other.node;
+        }
+
+    };
+
+
+    /*
+        Variable-Length Forward List Class (atl::varlen_forward_list)
+        Each node is allocated as a run of header-sized slots, so the allocator only ever
+        sees varlen_fwd_list_node and the payload keeps the header's alignment.
+    */
+    template<typename Allocator = allocator<varlen_fwd_list_node>>
+    class varlen_forward_list {
+    public:
+        using Node = varlen_fwd_list_node;
+        using Link = detail::fwd_link_base;
+        using Chain = detail::fwd_chain;
+        using Iterator = varlen_fwd_list_iterator;
+        using ConstIterator = varlen_fwd_list_iterator;
+
+        // Constructor initializing the list with the given allocator.
+        varlen_forward_list(const Allocator& a = Allocator()) noexcept
+            : head(nullptr), alloc(a) {}
+
+        // Destructor that clears the list.
+        ~varlen_forward_list() {
+            clear();
+        }
+
+        // Copy constructor, preserving the order of elements.
+        varlen_forward_list(const varlen_forward_list& other) : head(nullptr), alloc(other.alloc) {
+            copy_from(other);
+        }
+
+        // Move constructor.
+        varlen_forward_list(varlen_forward_list&& other) noexcept
+            : head(other.head), alloc(std::move(other.alloc)) {
+            other.head = nullptr;
+        }
+
+        // Copy assignment operator.
+        varlen_forward_list& operator=(const varlen_forward_list& other) {
+            if (this != &other) {
+                clear();
+                copy_from(other);
+            }
+            return *this;
+        }
+
+        // Move assignment operator.
+        varlen_forward_list& operator=(varlen_forward_list&& other) noexcept {
+            if (this != &other) {
+                clear();
+                head = other.head;
+                alloc = std::move(other.alloc);
+                other.head = nullptr;
+            }
+            return *this;
+        }
+
+        // Returns the allocator used by the list.
+        Allocator get_allocator() const noexcept {
+            return alloc;
+        }
+
+        // Returns a view of the first element in the list.
+        std::string_view front() const {
+            return as_node(head)->view();
+        }
+
+        // Returns the bytes of the first element in the list.
+        std::span<const std::byte> front_bytes() const {
+            return as_node(head)->bytes();
+        }
+
+        // Checks if the list is empty.
+        bool empty() const noexcept {
+            return head == nullptr;
+        }
+
+        // Returns the largest payload, in bytes, a single element can hold.
+        std::size_t max_size() const noexcept {
+            return (std::allocator_traits<Allocator>::max_size(alloc) - 1) * sizeof(Node);
+        }
+
+        // Inserts a copy of the given characters at the front of the list.
+        void push_front(std::string_view value) {
+            std::memcpy(emplace_front(value.size()).data(), value.data(), value.size());
+        }
+
+        // Inserts a copy of the given bytes at the front of the list.
+        void push_front(std::span<const std::byte> value) {
+            std::memcpy(emplace_front(value.size()).data(), value.data(), value.size());
+        }
+
+        // Inserts a node with size uninitialized payload bytes at the front and returns them for filling.
+        std::span<std::byte> emplace_front(std::size_t size) {
+            Node* new_node = create_node(size);
+            Chain::link_front(&head, new_node);
+            return std::span<std::byte>(reinterpret_cast<std::byte*>(new_node->data()), size);
+        }
+
+        // Removes the first element from the list.
+        void pop_front() {
+            if (head) destroy_node(as_node(Chain::unlink(&head)));
+        }
+
+        // Clears the list by destroying all nodes.
+        void clear() {
+            while (head) destroy_node(as_node(Chain::unlink(&head)));
+        }
+
+        // Swaps the contents of this list with other.
+        void swap(varlen_forward_list& other) noexcept {
+            std::swap(head, other.head);
+            std::swap(alloc, other.alloc);
+        }
+
+        // Removes all elements equal to value.
+        void remove(std::string_view value) {
+            Link** pos = &head;
+            while (*pos) {
+                if (as_node(*pos)->view() == value) {
+                    destroy_node(as_node(Chain::unlink(pos)));
+                } else {
+                    pos = &(*pos)->next;
+                }
+            }
+        }
+
+        // Reverses the order of elements in the list.
+        void reverse() {
+            head = Chain::reverse(head);
+        }
+
+        // Returns an iterator to the beginning of the list.
+        Iterator begin() const noexcept {
+            return Iterator(as_node(head));
+        }
+
+        // Returns an iterator to the end of the list.
+        Iterator end() const noexcept {
+            return Iterator(nullptr);
+        }
+
+        // Returns a constant iterator to the beginning of the list.
+        ConstIterator cbegin() const noexcept {
+            return ConstIterator(as_node(head));
+        }
+
+        // Returns a constant iterator to the end of the list.
+        ConstIterator cend() const noexcept {
+            return ConstIterator(nullptr);
+        }
+
+    private:
+        Link* head; // Pointer to the head node of the list.
+        Allocator alloc; // Allocator used to allocate and deallocate the slots of each node.
+
+        // Returns the node containing link.
+        static Node* as_node(Link* link) noexcept {
+            return static_cast<Node*>(link);
+        }
+
+        // Returns the constant node containing link.
+        static const Node* as_node(const Link* link) noexcept {
+            return static_cast<const Node*>(link);
+        }
+
+        // Allocates a node with room for size payload bytes in a single allocation, throwing
+        // std::length_error when size exceeds max_size().
+        Node* create_node(std::size_t size) {
+            if (size > max_size()) throw std::length_error("atl::varlen_forward_list: payload too large");
+            Node* node = alloc.allocate(Node::slots(size));
+            ::new(static_cast<void*>(node)) Node();
+            node->size = size;
+            return node;
+        }
+
+        // Deallocates the node together with its payload.
+        void destroy_node(Node* node) {
+            alloc.deallocate(node, Node::slots(node->size));
+        }
+
+        // Appends copies of the elements of other, preserving their order.
+        void copy_from(const varlen_forward_list& other) {
+            Link** tail = Chain::end_link(&head);
+            for (const Link* link = other.head; link; link = link->next) {
+                const Node* current = as_node(link);
+                Node* node = create_node(current->size);
+                std::memcpy(node->data(), current->data(), current->size);
+                Chain::append(tail, node);
+            }
+        }
+    };
+
+} // namespace atl
+
+#endif // VARLEN_FORWARD_LIST_H